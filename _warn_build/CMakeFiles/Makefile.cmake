@@ -0,0 +1,71 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/tests/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/bench_source_index.dir/DependInfo.cmake"
+  "CMakeFiles/test_slot_map.dir/DependInfo.cmake"
+  "CMakeFiles/bench_slot_map.dir/DependInfo.cmake"
+  "CMakeFiles/test_stage_math.dir/DependInfo.cmake"
+  "CMakeFiles/test_hitting_times.dir/DependInfo.cmake"
+  "CMakeFiles/bench_hitting_times.dir/DependInfo.cmake"
+  "CMakeFiles/test_merge_almost_same.dir/DependInfo.cmake"
+  "CMakeFiles/bench_merge_almost_same.dir/DependInfo.cmake"
+  "CMakeFiles/test_catch_up.dir/DependInfo.cmake"
+  "CMakeFiles/bench_catch_up.dir/DependInfo.cmake"
+  "CMakeFiles/test_clean_up_schedule.dir/DependInfo.cmake"
+  "CMakeFiles/test_move_instances.dir/DependInfo.cmake"
+  "CMakeFiles/bench_move_instances.dir/DependInfo.cmake"
+  "CMakeFiles/test_spatial_hash_grid.dir/DependInfo.cmake"
+  "CMakeFiles/bench_spatial_hash_grid.dir/DependInfo.cmake"
+  "CMakeFiles/test_sweep_and_prune.dir/DependInfo.cmake"
+  "CMakeFiles/bench_sweep_and_prune.dir/DependInfo.cmake"
+  "CMakeFiles/test_time_jump.dir/DependInfo.cmake"
+  "CMakeFiles/bench_time_jump.dir/DependInfo.cmake"
+  "CMakeFiles/test_touch_stamps.dir/DependInfo.cmake"
+  "CMakeFiles/test_snapshot.dir/DependInfo.cmake"
+  "CMakeFiles/bench_snapshot.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/bench_catch_up.cpp" "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o" "gcc" "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_catch_up.dir/cmake_pch.hxx" "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o" "gcc" "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.cxx" "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_catch_up.dir/cmake_pch.hxx" "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch.d"
+  "/root/repo/src/HittingTimes.cpp" "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o" "gcc" "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_catch_up.dir/cmake_pch.hxx" "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o" "gcc" "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
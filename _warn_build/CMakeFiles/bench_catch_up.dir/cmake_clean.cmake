@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o"
+  "CMakeFiles/bench_catch_up.dir/bench_catch_up.cpp.o.d"
+  "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_catch_up.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/bench_catch_up.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "bench_catch_up"
+  "bench_catch_up.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_catch_up.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
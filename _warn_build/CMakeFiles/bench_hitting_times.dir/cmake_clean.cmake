@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_hitting_times.dir/bench_hitting_times.cpp.o"
+  "CMakeFiles/bench_hitting_times.dir/bench_hitting_times.cpp.o.d"
+  "CMakeFiles/bench_hitting_times.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_hitting_times.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/bench_hitting_times.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/bench_hitting_times.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "bench_hitting_times"
+  "bench_hitting_times.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_hitting_times.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
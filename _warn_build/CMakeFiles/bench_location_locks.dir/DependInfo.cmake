@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/bench_location_locks.cpp" "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o" "gcc" "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_location_locks.dir/cmake_pch.hxx" "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o" "gcc" "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.cxx" "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch.d"
+  "/root/repo/_warn_build/CMakeFiles/bench_location_locks.dir/cmake_pch.hxx" "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
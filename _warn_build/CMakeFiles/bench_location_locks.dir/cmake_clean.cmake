@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o"
+  "CMakeFiles/bench_location_locks.dir/bench_location_locks.cpp.o.d"
+  "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_location_locks.dir/cmake_pch.hxx.gch.d"
+  "bench_location_locks"
+  "bench_location_locks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_location_locks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_merge_almost_same.dir/bench_merge_almost_same.cpp.o"
+  "CMakeFiles/bench_merge_almost_same.dir/bench_merge_almost_same.cpp.o.d"
+  "CMakeFiles/bench_merge_almost_same.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_merge_almost_same.dir/cmake_pch.hxx.gch.d"
+  "bench_merge_almost_same"
+  "bench_merge_almost_same.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_merge_almost_same.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
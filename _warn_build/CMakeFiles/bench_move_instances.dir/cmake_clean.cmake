@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_move_instances.dir/bench_move_instances.cpp.o"
+  "CMakeFiles/bench_move_instances.dir/bench_move_instances.cpp.o.d"
+  "CMakeFiles/bench_move_instances.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_move_instances.dir/cmake_pch.hxx.gch.d"
+  "bench_move_instances"
+  "bench_move_instances.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_move_instances.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_slot_map.dir/bench_slot_map.cpp.o"
+  "CMakeFiles/bench_slot_map.dir/bench_slot_map.cpp.o.d"
+  "CMakeFiles/bench_slot_map.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_slot_map.dir/cmake_pch.hxx.gch.d"
+  "bench_slot_map"
+  "bench_slot_map.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_slot_map.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
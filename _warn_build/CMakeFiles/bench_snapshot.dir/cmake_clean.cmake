@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_snapshot.dir/bench_snapshot.cpp.o"
+  "CMakeFiles/bench_snapshot.dir/bench_snapshot.cpp.o.d"
+  "CMakeFiles/bench_snapshot.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_snapshot.dir/cmake_pch.hxx.gch.d"
+  "bench_snapshot"
+  "bench_snapshot.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_snapshot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
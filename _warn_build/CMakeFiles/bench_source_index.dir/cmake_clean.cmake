@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_source_index.dir/bench_source_index.cpp.o"
+  "CMakeFiles/bench_source_index.dir/bench_source_index.cpp.o.d"
+  "CMakeFiles/bench_source_index.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_source_index.dir/cmake_pch.hxx.gch.d"
+  "bench_source_index"
+  "bench_source_index.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_source_index.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_spatial_hash_grid.dir/bench_spatial_hash_grid.cpp.o"
+  "CMakeFiles/bench_spatial_hash_grid.dir/bench_spatial_hash_grid.cpp.o.d"
+  "CMakeFiles/bench_spatial_hash_grid.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_spatial_hash_grid.dir/cmake_pch.hxx.gch.d"
+  "bench_spatial_hash_grid"
+  "bench_spatial_hash_grid.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_spatial_hash_grid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
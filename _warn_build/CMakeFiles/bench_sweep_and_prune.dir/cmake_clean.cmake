@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_sweep_and_prune.dir/bench_sweep_and_prune.cpp.o"
+  "CMakeFiles/bench_sweep_and_prune.dir/bench_sweep_and_prune.cpp.o.d"
+  "CMakeFiles/bench_sweep_and_prune.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_sweep_and_prune.dir/cmake_pch.hxx.gch.d"
+  "bench_sweep_and_prune"
+  "bench_sweep_and_prune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_sweep_and_prune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_time_jump.dir/bench_time_jump.cpp.o"
+  "CMakeFiles/bench_time_jump.dir/bench_time_jump.cpp.o.d"
+  "CMakeFiles/bench_time_jump.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/bench_time_jump.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/bench_time_jump.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/bench_time_jump.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "bench_time_jump"
+  "bench_time_jump.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_time_jump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
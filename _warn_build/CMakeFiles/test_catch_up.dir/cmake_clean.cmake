@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_catch_up.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_catch_up.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_catch_up.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/test_catch_up.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "CMakeFiles/test_catch_up.dir/test_catch_up.cpp.o"
+  "CMakeFiles/test_catch_up.dir/test_catch_up.cpp.o.d"
+  "test_catch_up"
+  "test_catch_up.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_catch_up.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_clean_up_schedule.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_clean_up_schedule.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_clean_up_schedule.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/test_clean_up_schedule.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "CMakeFiles/test_clean_up_schedule.dir/test_clean_up_schedule.cpp.o"
+  "CMakeFiles/test_clean_up_schedule.dir/test_clean_up_schedule.cpp.o.d"
+  "test_clean_up_schedule"
+  "test_clean_up_schedule.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_clean_up_schedule.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hitting_times.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_hitting_times.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_hitting_times.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/test_hitting_times.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "CMakeFiles/test_hitting_times.dir/test_hitting_times.cpp.o"
+  "CMakeFiles/test_hitting_times.dir/test_hitting_times.cpp.o.d"
+  "test_hitting_times"
+  "test_hitting_times.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_hitting_times.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_location_locks.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_location_locks.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_location_locks.dir/test_location_locks.cpp.o"
+  "CMakeFiles/test_location_locks.dir/test_location_locks.cpp.o.d"
+  "test_location_locks"
+  "test_location_locks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_location_locks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_merge_almost_same.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_merge_almost_same.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_merge_almost_same.dir/test_merge_almost_same.cpp.o"
+  "CMakeFiles/test_merge_almost_same.dir/test_merge_almost_same.cpp.o.d"
+  "test_merge_almost_same"
+  "test_merge_almost_same.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_merge_almost_same.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_move_instances.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_move_instances.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_move_instances.dir/test_move_instances.cpp.o"
+  "CMakeFiles/test_move_instances.dir/test_move_instances.cpp.o.d"
+  "test_move_instances"
+  "test_move_instances.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_move_instances.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
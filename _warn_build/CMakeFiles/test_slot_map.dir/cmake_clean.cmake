@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_slot_map.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_slot_map.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_slot_map.dir/test_slot_map.cpp.o"
+  "CMakeFiles/test_slot_map.dir/test_slot_map.cpp.o.d"
+  "test_slot_map"
+  "test_slot_map.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_slot_map.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
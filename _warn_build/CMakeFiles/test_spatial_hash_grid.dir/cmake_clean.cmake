@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_spatial_hash_grid.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_spatial_hash_grid.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_spatial_hash_grid.dir/test_spatial_hash_grid.cpp.o"
+  "CMakeFiles/test_spatial_hash_grid.dir/test_spatial_hash_grid.cpp.o.d"
+  "test_spatial_hash_grid"
+  "test_spatial_hash_grid.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_spatial_hash_grid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stage_math.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_stage_math.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_stage_math.dir/test_stage_math.cpp.o"
+  "CMakeFiles/test_stage_math.dir/test_stage_math.cpp.o.d"
+  "test_stage_math"
+  "test_stage_math.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stage_math.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
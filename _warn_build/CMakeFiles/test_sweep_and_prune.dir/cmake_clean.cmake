@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sweep_and_prune.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_sweep_and_prune.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_sweep_and_prune.dir/test_sweep_and_prune.cpp.o"
+  "CMakeFiles/test_sweep_and_prune.dir/test_sweep_and_prune.cpp.o.d"
+  "test_sweep_and_prune"
+  "test_sweep_and_prune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sweep_and_prune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/_warn_build/CMakeFiles/test_time_jump.dir/cmake_pch.hxx.cxx" "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch.d"
+  "/root/repo/_warn_build/CMakeFiles/test_time_jump.dir/cmake_pch.hxx" "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch" "gcc" "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch.d"
+  "/root/repo/src/HittingTimes.cpp" "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o" "gcc" "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/test_time_jump.dir/cmake_pch.hxx" "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o" "gcc" "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "/root/repo/tests/test_time_jump.cpp" "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o" "gcc" "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o.d"
+  "/root/repo/_warn_build/CMakeFiles/test_time_jump.dir/cmake_pch.hxx" "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o" "gcc" "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_time_jump.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o"
+  "CMakeFiles/test_time_jump.dir/root/repo/src/HittingTimes.cpp.o.d"
+  "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o"
+  "CMakeFiles/test_time_jump.dir/test_time_jump.cpp.o.d"
+  "test_time_jump"
+  "test_time_jump.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_time_jump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
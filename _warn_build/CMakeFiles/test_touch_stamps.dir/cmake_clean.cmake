@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_touch_stamps.dir/cmake_pch.hxx.gch"
+  "CMakeFiles/test_touch_stamps.dir/cmake_pch.hxx.gch.d"
+  "CMakeFiles/test_touch_stamps.dir/test_touch_stamps.cpp.o"
+  "CMakeFiles/test_touch_stamps.dir/test_touch_stamps.cpp.o.d"
+  "test_touch_stamps"
+  "test_touch_stamps.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_touch_stamps.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,50 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_warn_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[bench_source_index]=] "/root/repo/_warn_build/bench_source_index" "--quick")
+set_tests_properties([=[bench_source_index]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;39;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[slot_map]=] "/root/repo/_warn_build/test_slot_map")
+set_tests_properties([=[slot_map]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;41;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_slot_map]=] "/root/repo/_warn_build/bench_slot_map" "--quick")
+set_tests_properties([=[bench_slot_map]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;42;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[stage_math]=] "/root/repo/_warn_build/test_stage_math")
+set_tests_properties([=[stage_math]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;44;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[hitting_times]=] "/root/repo/_warn_build/test_hitting_times")
+set_tests_properties([=[hitting_times]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;46;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_hitting_times]=] "/root/repo/_warn_build/bench_hitting_times" "--quick")
+set_tests_properties([=[bench_hitting_times]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;47;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[merge_almost_same]=] "/root/repo/_warn_build/test_merge_almost_same")
+set_tests_properties([=[merge_almost_same]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;49;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_merge_almost_same]=] "/root/repo/_warn_build/bench_merge_almost_same" "--quick")
+set_tests_properties([=[bench_merge_almost_same]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;50;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[catch_up]=] "/root/repo/_warn_build/test_catch_up")
+set_tests_properties([=[catch_up]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;52;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_catch_up]=] "/root/repo/_warn_build/bench_catch_up" "--quick")
+set_tests_properties([=[bench_catch_up]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;53;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[clean_up_schedule]=] "/root/repo/_warn_build/test_clean_up_schedule")
+set_tests_properties([=[clean_up_schedule]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;54;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[move_instances]=] "/root/repo/_warn_build/test_move_instances")
+set_tests_properties([=[move_instances]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;56;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_move_instances]=] "/root/repo/_warn_build/bench_move_instances" "--quick")
+set_tests_properties([=[bench_move_instances]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;57;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[spatial_hash_grid]=] "/root/repo/_warn_build/test_spatial_hash_grid")
+set_tests_properties([=[spatial_hash_grid]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;59;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_spatial_hash_grid]=] "/root/repo/_warn_build/bench_spatial_hash_grid" "--quick")
+set_tests_properties([=[bench_spatial_hash_grid]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;60;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[sweep_and_prune]=] "/root/repo/_warn_build/test_sweep_and_prune")
+set_tests_properties([=[sweep_and_prune]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;62;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_sweep_and_prune]=] "/root/repo/_warn_build/bench_sweep_and_prune" "--quick")
+set_tests_properties([=[bench_sweep_and_prune]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;63;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[time_jump]=] "/root/repo/_warn_build/test_time_jump")
+set_tests_properties([=[time_jump]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;65;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_time_jump]=] "/root/repo/_warn_build/bench_time_jump" "--quick")
+set_tests_properties([=[bench_time_jump]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;66;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[touch_stamps]=] "/root/repo/_warn_build/test_touch_stamps")
+set_tests_properties([=[touch_stamps]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;68;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[snapshot]=] "/root/repo/_warn_build/test_snapshot")
+set_tests_properties([=[snapshot]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;29;add_test;/root/repo/tests/CMakeLists.txt;69;add_headless_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test([=[bench_snapshot]=] "/root/repo/_warn_build/bench_snapshot" "--quick")
+set_tests_properties([=[bench_snapshot]=] PROPERTIES  LABELS "bench" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;70;add_headless_bench;/root/repo/tests/CMakeLists.txt;0;")
@@ -14,4 +14,18 @@ set(headers ${headers}
 	include/Data.h
 	include/FormIDReader.h
 	include/Threading.h
+	include/SlotMap.h
+	include/InventorySnapshot.h
+	include/SpatialHashGrid.h
+	include/ModulatorGrid.h
+	include/SweepAndPrune.h
+	include/CellScan.h
+	include/ContainerJournal.h
+	include/StageMath.h
+	include/HittingTimes.h
+	include/InstanceOps.h
+	include/CatchUp.h
+	include/TimeJump.h
+	include/TouchStamps.h
+	include/Snapshot.h
 )
\ No newline at end of file
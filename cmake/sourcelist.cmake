@@ -12,4 +12,8 @@ set(sources ${sources}
 	src/CustomObjects.cpp
 	src/Data.cpp
 	src/FormIDReader.cpp
+	src/HittingTimes.cpp
+	src/ModulatorGrid.cpp
+	src/CellScan.cpp
+	src/ContainerJournal.cpp
 )
@@ -0,0 +1,117 @@
+#pragma once
+
+namespace Evolution {
+    struct Rules;
+}
+
+// The clock of a stage instance: how far into its stage it is at a given time and how the time modulators bend that.
+// Knows nothing about the game, Xtra is what the instance shows as (Types::FormEditorIDX in the plugin, needs
+// form_id, is_fake, is_decayed, is_transforming, == and Identical). StageInstance adds the game side.
+template <typename Xtra>
+struct BasicStageInstance {
+    float start_time; // start time of the stage
+    unsigned int no;  // StageNo
+    Count count;
+    Xtra xtra;
+
+    BasicStageInstance(const float st, const unsigned int n, const Count c)
+        : start_time(st), no(n), count(c), _elapsed(0), _delay_start(st), _delay_mag(1), _delay_formid(0) {}
+
+    // times are very close (abs diff less than 0.015h = 0.9min)
+    // assumes that they are in the same inventory
+    [[nodiscard]] bool AlmostSameExceptCount(const BasicStageInstance& other, const float curr_time) const {
+        // bcs they are in the same inventory they will have same delay magnitude
+        // delay starts might be different but if the elapsed times are close enough, we don't care
+        return no == other.no && std::abs(start_time - other.start_time) < 0.015 &&
+               std::abs(GetElapsed(curr_time) - other.GetElapsed(curr_time)) < 0.015 && xtra == other.xtra;
+    }
+
+    // bit for bit, all members. == only looks at some of them and up to EPSILON
+    [[nodiscard]] bool Identical(const BasicStageInstance& other) const {
+        const auto bits = [](const float f) { return std::bit_cast<uint32_t>(f); };
+        return bits(start_time) == bits(other.start_time) && no == other.no && count == other.count &&
+               xtra.Identical(other.xtra) && bits(_elapsed) == bits(other._elapsed) &&
+               bits(_delay_start) == bits(other._delay_start) && bits(_delay_mag) == bits(other._delay_mag) &&
+               _delay_formid == other._delay_formid;
+    }
+
+    [[nodiscard]] float GetElapsed(const float curr_time) const {
+        if (std::fabs(_delay_mag) < EPSILON) return _elapsed;
+        return (curr_time - _delay_start) * GetDelaySlope() + _elapsed;
+    }
+
+    [[nodiscard]] float GetDelaySlope() const { return std::min(std::max(-1000.f, _delay_mag), 1000.f); }
+
+    void SetNewStart(const float curr_time, const float overshot) {
+        // overshot: by how much is the schwelle already ueberschritten
+        start_time = curr_time - overshot / (GetDelaySlope() + std::numeric_limits<float>::epsilon());
+        _delay_start = start_time;
+        _elapsed = 0;
+    }
+
+    // these return false if nothing changed
+    bool SetDelay(const float time, const float delay, const FormID formid) {
+        // yeni steigungla yeni ausgangspunkt yapiyoruz
+        if (xtra.is_transforming) return false;
+        if (std::fabs(_delay_mag - delay) < EPSILON && _delay_formid == formid) return false;
+
+        _elapsed = GetElapsed(time);
+        _delay_start = time;
+        _delay_mag = delay;
+        _delay_formid = formid;
+        return true;
+    }
+
+    bool SetTransform(const float time, const FormID formid) {
+        if (xtra.is_transforming) {
+            if (_delay_formid != formid) {
+                RemoveTransform(time);
+                SetTransform(time, formid);
+                return true;
+            }
+            return false;
+        }
+        SetDelay(time, 1, formid);
+        xtra.is_transforming = true;
+        return true;
+    }
+
+    [[nodiscard]] float GetTransformElapsed(const float curr_time) const { return GetElapsed(curr_time) - _elapsed; }
+
+    bool RemoveTransform(const float curr_time) {
+        if (!xtra.is_transforming) return false;
+        xtra.is_transforming = false;
+        _delay_start = curr_time;
+        _delay_mag = 1;
+        _delay_formid = 0;
+        return true;
+    }
+
+    bool RemoveTimeMod(const float time) {
+        const bool removed = RemoveTransform(time);
+        return SetDelay(time, 1, 0) || removed;
+    }
+
+    [[nodiscard]] float GetDelayMagnitude() const { return GetDelaySlope(); }
+
+    [[nodiscard]] FormID GetDelayerFormID() const { return _delay_formid; }
+
+    [[nodiscard]] float GetHittingTime(const float schranke) const {
+        // _elapsed + dt*_delay_mag = schranke
+        return _delay_start + (schranke - _elapsed) / (GetDelaySlope() + std::numeric_limits<float>::epsilon());
+    }
+
+    [[nodiscard]] float GetTransformHittingTime(const float schranke) const {
+        if (!xtra.is_transforming) return 0;
+        return GetHittingTime(schranke + _elapsed);
+    }
+
+protected:
+    // GatherHittingInputs reads the clock as it is
+    friend struct Evolution::Rules;
+
+    float _elapsed; // y coord of the ausgangspunkt/elapsed time since the stage started
+    float _delay_start;  // x coord of the ausgangspunkt
+    float _delay_mag; // slope
+    FormID _delay_formid; // formid of the time modulator
+};
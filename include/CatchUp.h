@@ -0,0 +1,555 @@
+#pragma once
+#include <queue>
+#include "InstanceOps.h"
+
+// Catch-up of one inventory to the current time, stepping like the old loop did:
+//   t = earliest next update time of any instance there + step_margin, update everything at t,
+//   stop at the first step that moves no instance on or once t reaches the current time.
+// The old loop updated, modulated and cleaned up every instance at every step. A step here only looks at
+//  - the instances that change at t: every instance is queued at the first time at which updating it changes it,
+//    found by trying the real update (FireTime). before that time the full pass would have left it as it is
+//  - for the modulation, the instances that changed since the last pass, unless the modulators of the source changed
+//  - for the clean up, the instances that changed since the last one plus the almost same pairs that survived it
+// and is bit for bit the old step otherwise (test_catch_up). Rows keep the keys of the instances in the vectors of
+// the sources and are compacted with them when instances get erased.
+// Still O(n) per step: a source that freezes here is modulated in full (freezing restarts the delay every time),
+// and an erase moves the instances behind it.
+// Knows nothing about the game. Model is the inventory being updated, see Manager::InventoryCatchUp:
+//   Instance, Slot, Inputs          Instance has no, count, start_time, xtra.form_id and AlmostSameExceptCount
+//   SourcesAt()                     sources with instances here, in update order
+//   Instances(slot)                 nullptr if the source has nothing here or is not healthy
+//   UpdateStage(slot, inst, t)      UpdateAllStages for one instance, true if it moved on (the update is queued)
+//   WouldChange(slot, inst, t)      if UpdateStage would change inst at t
+//   NextUpdateTime(slot, inst)      what the old loop stepped to, 0 for none
+//   CleanUp(slot)                   CleanUpData
+//   CleanUpOthers(slot)             CleanUpData without this location, true if this one is due as well
+//   ShouldErase(slot, inst)         the erase test of CleanUpLocation
+//   Erased(slot, n)                 n instances were erased here, maybe all of them
+//   ApplyUpdates(slot, t)           the queued updates in the inventory, decayed items registered
+//   GetInputs(slot), Modulate(slot, inst, inputs, t), MarkDirty(slot)   the modulation of StepInventory in parts
+//   Identical(a, b)                 bit for bit
+
+// Manager::UpdateInventory(ref, t), the step of the old loop: every instance here updated, cleaned up and modulated
+// at t. CatchUp does it for the first step and the ones that go back in time. true if an instance moved on
+template <typename Model>
+bool StepInventory(Model& a_model, const float t) {
+    bool moved = false;
+    for (const auto slot : a_model.SourcesAt()) {
+        auto* instances = a_model.Instances(slot);
+        if (!instances || instances->empty()) continue;
+        for (auto& inst : *instances) {
+            if (a_model.UpdateStage(slot, inst, t)) moved = true;
+        }
+        a_model.CleanUp(slot);
+        a_model.ApplyUpdates(slot, t);
+    }
+    for (const auto slot : a_model.SourcesAt()) {
+        auto* instances = a_model.Instances(slot);
+        if (!instances || instances->empty()) continue;
+        const auto inputs = a_model.GetInputs(slot);
+        bool changed = false;
+        for (auto& inst : *instances) {
+            if (inst.count <= 0) continue;
+            if (a_model.Modulate(slot, inst, inputs, t)) changed = true;
+        }
+        if (changed) a_model.MarkDirty(slot);
+    }
+    return moved;
+}
+
+template <typename Model>
+class CatchUp {
+public:
+    using Instance = typename Model::Instance;
+    using Slot = typename Model::Slot;
+    using Inputs = typename Model::Inputs;
+
+    static constexpr float step_margin = 0.000028f;
+    // up to this many instances the full steps are cheaper than the bookkeeping (bench_catch_up)
+    static constexpr size_t small_inventory = 16;
+
+    struct Stats {
+        size_t steps = 0;
+        size_t full_steps = 0;    // the first one, and the ones that went back in time
+        size_t updated = 0;       // UpdateStage calls
+        size_t modulated = 0;     // Modulate calls
+        size_t cleaned = 0;       // instances looked at by the clean ups
+        size_t probes = 0;        // WouldChange calls
+    };
+
+    CatchUp(Model& a_model, const float a_curr_time, const size_t a_small_inventory = small_inventory)
+        : model_(a_model), curr_time_(a_curr_time), small_inventory_(a_small_inventory) {}
+
+    // the steps before a_curr_time, the update at a_curr_time is up to the caller.
+    // returns the time of the step that moved nothing on if that is where it stopped
+    std::optional<float> Run() {
+        float t = 0.f;
+        size_t n = 0;
+        if (!FirstTime(t, n) || t >= curr_time_) return std::nullopt;
+        ++stats_.steps;
+        ++stats_.full_steps;
+        if (!StepInventory(model_, t)) return t;
+        if (n <= small_inventory_) {
+            while (FirstTime(t, n) && t < curr_time_) {
+                ++stats_.steps;
+                ++stats_.full_steps;
+                if (!StepInventory(model_, t)) return t;
+            }
+            return std::nullopt;
+        }
+        Build(t);
+        float prev = t;
+        while (NextTime(t) && t < curr_time_) {
+            ++stats_.steps;
+            bool moved;
+            // the queued times only hold from the time they were made at on. the old loop can step back
+            // when an instance is overdue and never moves on, that step is done in full
+            if (t < prev) {
+                ++stats_.full_steps;
+                moved = StepInventory(model_, t);
+                Build(t);
+            }
+            else moved = Step(t);
+            prev = t;
+            if (!moved) return t;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const Stats& GetStats() const { return stats_; }
+
+private:
+    using No = decltype(std::declval<Instance>().no);
+    using Form = decltype(std::declval<Instance>().xtra.form_id);
+    using SortKey = std::tuple<No, Form, float, uint32_t>;  // MergeAlmostSame's order, then the row
+
+    struct Row {
+        Slot slot;
+        size_t idx;              // in the instance vector
+        uint32_t stamp = 0;      // queue entries with another stamp are stale
+        bool alive = true;
+        bool rekey = false;      // changed in this step
+        bool touched = false;    // changed since the last clean up
+        bool modulate = false;   // changed since the last modulation
+        bool in_sorted = false;
+        SortKey key{};
+    };
+
+    struct Lane {
+        std::vector<Instance>* vec = nullptr;
+        std::vector<uint32_t> ids;  // row of every instance, in the order of the vector
+        std::set<SortKey> sorted;
+        std::vector<uint32_t> touched;
+        std::vector<uint32_t> modulate;
+        std::vector<uint32_t> fresh;  // added in this step
+        std::vector<std::pair<uint32_t, uint32_t>> residual;  // almost same pairs left after the last clean up
+        std::optional<Inputs> inputs;  // what every instance was last modulated with
+        bool all_touched = false;
+    };
+
+    struct Entry {
+        float time;
+        uint32_t row;
+        uint32_t stamp;
+        bool operator>(const Entry& other) const { return time > other.time; }
+    };
+    using Queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>;
+
+    // n: number of instances
+    bool FirstTime(float& t, size_t& n) {
+        float earliest = 0.f;
+        n = 0;
+        for (const auto slot : model_.SourcesAt()) {
+            auto* vec = model_.Instances(slot);
+            if (!vec) continue;
+            n += vec->size();
+            for (auto& inst : *vec) {
+                if (const auto h = model_.NextUpdateTime(slot, inst); h > 0 && (earliest <= 0 || h < earliest)) earliest = h;
+            }
+        }
+        if (earliest <= 0) return false;
+        t = earliest + step_margin;
+        return true;
+    }
+
+    bool NextTime(float& t) {
+        while (!times_.empty() && !IsValid(times_.top())) times_.pop();
+        if (times_.empty()) return false;
+        t = times_.top().time + step_margin;
+        return true;
+    }
+
+    [[nodiscard]] bool IsValid(const Entry& e) const {
+        const auto& row = rows_[e.row];
+        return row.alive && row.stamp == e.stamp;
+    }
+
+    Instance& InstanceOf(const uint32_t id) {
+        const auto& row = rows_[id];
+        return (*lanes_.at(row.slot).vec)[row.idx];
+    }
+
+    // everything from scratch after a full step at t
+    void Build(const float t) {
+        rows_.clear();
+        lanes_.clear();
+        rekey_.clear();
+        times_ = Queue();
+        fires_ = Queue();
+        for (const auto slot : model_.SourcesAt()) {
+            auto* vec = model_.Instances(slot);
+            if (!vec || vec->empty()) continue;
+            auto& lane = lanes_[slot];
+            lane.vec = vec;
+            // the full step did not necessarily clean this location up
+            lane.all_touched = true;
+            lane.inputs = model_.GetInputs(slot);
+            for (size_t i = 0; i < vec->size(); ++i) AddRow(slot, lane);
+        }
+        for (uint32_t id = 0; id < rows_.size(); ++id) Key(id, t);
+    }
+
+    uint32_t AddRow(const Slot a_slot, Lane& a_lane) {
+        const auto id = static_cast<uint32_t>(rows_.size());
+        rows_.push_back({a_slot, a_lane.ids.size()});
+        a_lane.ids.push_back(id);
+        return id;
+    }
+
+    void Key(const uint32_t id, const float t) {
+        auto& row = rows_[id];
+        auto& inst = InstanceOf(id);
+        ++row.stamp;
+        const auto next = model_.NextUpdateTime(row.slot, inst);
+        if (next > 0) times_.push({next, id, row.stamp});
+        if (const auto fire = FireTime(row.slot, inst, t, next); fire < std::numeric_limits<float>::infinity()) {
+            fires_.push({fire, id, row.stamp});
+        }
+    }
+
+    // first float time >= a_time at which updating a_inst changes it, inf if there is none.
+    // if it doesn't change at a_time, it changes at every time from the first one on: the elapsed time only runs one way
+    // and the update compares it with fixed thresholds. so a search over the float bits, starting at the hitting time
+    float FireTime(const Slot a_slot, const Instance& a_inst, const float a_time, const float a_hint) {
+        const auto changes = [&](const uint32_t bits) {
+            ++stats_.probes;
+            return model_.WouldChange(a_slot, a_inst, std::bit_cast<float>(bits));
+        };
+        constexpr float far = std::numeric_limits<float>::max();
+        ++stats_.probes;
+        if (model_.WouldChange(a_slot, a_inst, a_time)) return a_time;
+        // the bits of non-negative floats are in the same order as the floats
+        if (!(a_time >= 0.f) || !(a_time < far)) return a_time;
+
+        uint64_t lo = std::bit_cast<uint32_t>(a_time + 0.f);  // no -0
+        uint64_t hi = std::bit_cast<uint32_t>(far);
+        const bool has_hint = a_hint > a_time && a_hint < far;
+        if (const uint64_t hint = has_hint ? std::bit_cast<uint32_t>(a_hint) : 0; has_hint && changes(static_cast<uint32_t>(hint))) {
+            hi = hint;
+            for (uint64_t d = 1; hint - d > lo; d *= 2) {
+                if (!changes(static_cast<uint32_t>(hint - d))) {
+                    lo = hint - d;
+                    break;
+                }
+                hi = hint - d;
+            }
+        }
+        else {
+            if (!changes(static_cast<uint32_t>(hi))) return std::numeric_limits<float>::infinity();
+            if (has_hint) {
+                lo = hint;
+                for (uint64_t d = 1; hint + d < hi; d *= 2) {
+                    if (changes(static_cast<uint32_t>(hint + d))) {
+                        hi = hint + d;
+                        break;
+                    }
+                    lo = hint + d;
+                }
+            }
+        }
+        while (hi - lo > 1) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (changes(static_cast<uint32_t>(mid))) hi = mid;
+            else lo = mid;
+        }
+        return std::bit_cast<float>(static_cast<uint32_t>(hi));
+    }
+
+    void Rekey(const uint32_t id) {
+        auto& row = rows_[id];
+        if (row.rekey) return;
+        row.rekey = true;
+        rekey_.push_back(id);
+    }
+
+    void Touch(const uint32_t id, const bool a_cleanup = true) {
+        auto& row = rows_[id];
+        auto& lane = lanes_.at(row.slot);
+        if (a_cleanup && !row.touched) {
+            row.touched = true;
+            lane.touched.push_back(id);
+        }
+        if (!row.modulate) {
+            row.modulate = true;
+            lane.modulate.push_back(id);
+        }
+        Rekey(id);
+    }
+
+    void Kill(Lane& a_lane) {
+        for (const auto id : a_lane.ids) rows_[id].alive = false;
+    }
+
+    // picks up sources that came to this location and instances that were added at the end of a vector
+    void Sync() {
+        for (auto it = lanes_.begin(); it != lanes_.end();) {
+            if (auto* vec = model_.Instances(it->first); vec && !vec->empty()) {
+                it->second.vec = vec;
+                ++it;
+                continue;
+            }
+            Kill(it->second);
+            it = lanes_.erase(it);
+        }
+        for (const auto slot : model_.SourcesAt()) {
+            auto* vec = model_.Instances(slot);
+            if (!vec || vec->empty()) continue;
+            auto& lane = lanes_[slot];
+            lane.vec = vec;
+            if (vec->size() < lane.ids.size()) {
+                // not something a step does. take them as new ones
+                Kill(lane);
+                lane = Lane{};
+                lane.vec = vec;
+            }
+            while (lane.ids.size() < vec->size()) {
+                const auto id = AddRow(slot, lane);
+                Touch(id);
+                lane.fresh.push_back(id);
+            }
+        }
+    }
+
+    bool Step(const float t) {
+        due_.clear();
+        while (!fires_.empty() && fires_.top().time <= t) {
+            if (const auto e = fires_.top(); IsValid(e)) due_.push_back(e.row);
+            fires_.pop();
+        }
+        // UpdateAllStages goes through the instances of a source in order
+        std::ranges::sort(due_, [this](const uint32_t a, const uint32_t b) {
+            return std::tie(rows_[a].slot, rows_[a].idx) < std::tie(rows_[b].slot, rows_[b].idx);
+        });
+        Sync();
+
+        bool moved = false;
+        auto due_it = due_.begin();
+        for (const auto slot : model_.SourcesAt()) {
+            for (; due_it != due_.end() && rows_[*due_it].slot < slot; ++due_it) Rekey(*due_it);
+            const auto lane_it = lanes_.find(slot);
+            if (lane_it == lanes_.end()) continue;
+            auto* vec = lane_it->second.vec;
+
+            work_.clear();
+            for (; due_it != due_.end() && rows_[*due_it].slot == slot; ++due_it) {
+                if (rows_[*due_it].alive) work_.push_back(*due_it);
+            }
+            // the full pass would see what was added before this source's turn too
+            for (const auto id : lane_it->second.fresh) {
+                ++stats_.probes;
+                if (rows_[id].alive && model_.WouldChange(slot, InstanceOf(id), t)) work_.push_back(id);
+            }
+            std::ranges::sort(work_, [this](const uint32_t a, const uint32_t b) { return rows_[a].idx < rows_[b].idx; });
+            work_.erase(std::ranges::unique(work_).begin(), work_.end());
+            for (const auto id : work_) {
+                auto& inst = (*vec)[rows_[id].idx];
+                const Instance before = inst;
+                ++stats_.updated;
+                if (model_.UpdateStage(slot, inst, t)) moved = true;
+                if (!Model::Identical(before, inst)) Touch(id);
+                else Rekey(id);
+            }
+
+            if (model_.CleanUpOthers(slot)) CleanUp(slot);
+            model_.ApplyUpdates(slot, t);
+            Sync();
+        }
+        for (; due_it != due_.end(); ++due_it) Rekey(*due_it);
+
+        for (const auto slot : model_.SourcesAt()) {
+            const auto lane_it = lanes_.find(slot);
+            if (lane_it == lanes_.end()) continue;
+            Modulate(slot, lane_it->second, t);
+        }
+
+        for (const auto id : rekey_) {
+            rows_[id].rekey = false;
+            if (rows_[id].alive) Key(id, t);
+        }
+        rekey_.clear();
+        for (auto& lane : lanes_ | std::views::values) lane.fresh.clear();
+        return moved;
+    }
+
+    void Modulate(const Slot a_slot, Lane& a_lane, const float t) {
+        auto& vec = *a_lane.vec;
+        const auto inputs = model_.GetInputs(a_slot);
+        // with the same modulators a pass leaves the instances it already went over as they are.
+        // except when freezing, that restarts the delay every time
+        work_.clear();
+        if (inputs.freeze || !a_lane.inputs || !(*a_lane.inputs == inputs)) work_ = a_lane.ids;
+        else {
+            for (const auto id : a_lane.modulate) {
+                if (rows_[id].alive) work_.push_back(id);
+            }
+            std::ranges::sort(work_, [this](const uint32_t a, const uint32_t b) { return rows_[a].idx < rows_[b].idx; });
+        }
+        bool changed = false;
+        for (const auto id : work_) {
+            auto& inst = vec[rows_[id].idx];
+            if (inst.count <= 0) continue;
+            const Instance before = inst;
+            ++stats_.modulated;
+            if (model_.Modulate(a_slot, inst, inputs, t)) changed = true;
+            if (!Model::Identical(before, inst)) Touch(id);
+        }
+        // what a pass changed it leaves as it is the next time
+        for (const auto id : a_lane.modulate) rows_[id].modulate = false;
+        a_lane.modulate.clear();
+        if (changed) model_.MarkDirty(a_slot);
+        a_lane.inputs = inputs;
+    }
+
+    // CleanUpLocation on the instances that changed since the last clean up. the rest passed the erase test then
+    // and still do, and the only almost same pairs among them are the ones the last merge left (residual)
+    void CleanUp(const Slot a_slot) {
+        auto& lane = lanes_.at(a_slot);
+        auto& vec = *lane.vec;
+
+        work_.clear();
+        if (lane.all_touched) {
+            lane.all_touched = false;
+            lane.sorted.clear();
+            for (const auto id : lane.ids) {
+                rows_[id].touched = true;
+                rows_[id].in_sorted = false;
+            }
+            work_ = lane.ids;
+        }
+        else {
+            for (const auto id : lane.touched) {
+                if (rows_[id].alive) work_.push_back(id);
+            }
+        }
+        lane.touched.clear();
+        stats_.cleaned += work_.size();
+
+        for (const auto id : work_) {
+            auto& row = rows_[id];
+            if (row.in_sorted) lane.sorted.erase(row.key);
+            const auto& inst = vec[row.idx];
+            row.key = {inst.no, inst.xtra.form_id, inst.start_time, id};
+            lane.sorted.insert(row.key);
+            row.in_sorted = true;
+        }
+
+        // pairs in the order the pairwise loop meets them
+        pairs_.clear();
+        for (const auto& [a, b] : lane.residual) {
+            if (rows_[a].alive && rows_[b].alive && !rows_[a].touched && !rows_[b].touched) pairs_.emplace_back(a, b);
+        }
+        for (const auto x : work_) {
+            const auto& inst = vec[rows_[x].idx];
+            const auto visit = [&](const SortKey& a_key) {
+                const auto y = std::get<3>(a_key);
+                const auto& other = vec[rows_[y].idx];
+                if (other.no != inst.no || other.xtra.form_id != inst.xtra.form_id ||
+                    std::abs(inst.start_time - other.start_time) >= InstanceOps::merge_window) return false;
+                // both changed: only once
+                if (rows_[y].touched && rows_[y].idx < rows_[x].idx) return true;
+                const auto [i, j] = std::minmax(x, y, [this](const uint32_t a, const uint32_t b) { return rows_[a].idx < rows_[b].idx; });
+                if (vec[rows_[i].idx].AlmostSameExceptCount(vec[rows_[j].idx], curr_time_)) pairs_.emplace_back(i, j);
+                return true;
+            };
+            const auto it = lane.sorted.find(rows_[x].key);
+            for (auto prev = it; prev != lane.sorted.begin() && visit(*--prev);) {}
+            for (auto next = std::next(it); next != lane.sorted.end() && visit(*next); ++next) {}
+        }
+        std::ranges::sort(pairs_, [this](const auto& a, const auto& b) {
+            return std::pair(rows_[a.first].idx, rows_[a.second].idx) < std::pair(rows_[b.first].idx, rows_[b.second].idx);
+        });
+
+        merged_.clear();
+        for (const auto& [a, b] : pairs_) {
+            auto& into = vec[rows_[a].idx];
+            auto& from = vec[rows_[b].idx];
+            if (from.count <= 0) continue;
+            into.count += from.count;
+            from.count = 0;
+            merged_.push_back(a);
+            merged_.push_back(b);
+        }
+        for (const auto id : merged_) {
+            if (!rows_[id].touched) work_.push_back(id);
+        }
+        for (const auto id : work_) rows_[id].touched = false;
+
+        size_t n_erased = 0;
+        size_t first = vec.size();
+        for (const auto id : work_) {
+            auto& row = rows_[id];
+            if (!row.alive || !model_.ShouldErase(a_slot, vec[row.idx])) continue;
+            row.alive = false;
+            first = std::min(first, row.idx);
+            ++n_erased;
+        }
+        if (n_erased) {
+            // one pass from the first erased one on, in order like the erase loop
+            size_t w = first;
+            for (size_t r = first; r < vec.size(); ++r) {
+                const auto id = lane.ids[r];
+                if (!rows_[id].alive) {
+                    if (rows_[id].in_sorted) lane.sorted.erase(rows_[id].key);
+                    continue;
+                }
+                if (w != r) {
+                    vec[w] = vec[r];
+                    lane.ids[w] = id;
+                }
+                rows_[id].idx = w++;
+            }
+            vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(w), vec.end());
+            lane.ids.resize(w);
+        }
+
+        lane.residual.clear();
+        for (const auto& [a, b] : pairs_) {
+            if (rows_[a].alive && rows_[b].alive) lane.residual.emplace_back(a, b);
+        }
+        for (const auto id : merged_) {
+            if (rows_[id].alive) Touch(id, false);
+        }
+
+        model_.Erased(a_slot, n_erased);
+        if (!model_.Instances(a_slot) || vec.empty()) {
+            Kill(lane);
+            lanes_.erase(a_slot);
+        }
+    }
+
+    Model& model_;
+    float curr_time_;
+    size_t small_inventory_;
+    Stats stats_;
+
+    std::vector<Row> rows_;
+    std::map<Slot, Lane> lanes_;
+    Queue times_;  // NextUpdateTime of every row that has one
+    Queue fires_;  // FireTime of every row that has one
+    std::vector<uint32_t> rekey_;
+
+    std::vector<uint32_t> due_;
+    std::vector<uint32_t> work_;
+    std::vector<uint32_t> merged_;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs_;
+};
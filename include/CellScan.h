@@ -0,0 +1,45 @@
+#pragma once
+#include "ModulatorGrid.h"
+
+// Works through the references of a cell a slice per frame instead of all at once in the event that asked for it.
+// Nearest to the player first; each slice stops once Settings::cell_scan_budget_ms is used up and the rest
+// continues on the next frame through the SKSE task queue. A budget <= 0 handles everything right away.
+class CellScan {
+public:
+    using Handler = std::function<void(RE::TESObjectREFR*)>;
+
+    struct Stats {
+        size_t backlog = 0;
+        size_t last_slice_done = 0;
+        float last_slice_ms = 0.f;
+        size_t slices = 0;
+        size_t done = 0;
+    };
+
+    static CellScan* GetSingleton() {
+        static CellScan singleton;
+        return &singleton;
+    }
+
+    // replaces whatever is left from an earlier scan
+    void Start(const std::vector<RE::TESObjectREFR*>& a_refs, Handler a_handler);
+    void Cancel();
+
+    [[nodiscard]] Stats GetStats();
+
+private:
+    CellScan() = default;
+
+    void Schedule();
+    void RunSlice();
+
+    // refs handled together in one ModulatorGrid::Batch between budget checks
+    static constexpr size_t chunk_size = 16;
+
+    std::mutex mutex_;
+    // nearest last, so taking from the back is nearest first
+    std::vector<RefID> backlog_;
+    Handler handler_;
+    bool scheduled_ = false;
+    Stats stats_;
+};
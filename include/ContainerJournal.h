@@ -0,0 +1,51 @@
+#pragma once
+#include "Manager.h"
+
+// Collects the container to container moves of one frame and hands them to the Manager in one go at the next task
+// queue run. A move of the same form between the same two containers as the move right before it is summed into that
+// one, or cancels it out if it goes the other way, and every touched location gets a single UpdateRef instead of one
+// per event. Moves are applied in the order they came in.
+// Drops and pick ups are not journaled, the world side has to be handled while the ref still exists.
+// A Manager::Update of a location with pending moves flushes them first, so it never sees the registry behind.
+// A flush runs Manager::Update(moves), so the flush mutex is never taken under a Manager lock.
+class ContainerJournal {
+public:
+    struct Stats {
+        size_t events = 0;  // moves recorded
+        size_t moves = 0;  // moves applied after netting
+        size_t updates = 0;  // UpdateRef calls
+        size_t flushes = 0;
+        size_t early = 0;  // flushes an Update asked for before the task queue run
+    };
+
+    static ContainerJournal* GetSingleton() {
+        static ContainerJournal singleton;
+        return &singleton;
+    }
+
+    void Record(Manager* a_manager, RefID a_from, RefID a_to, FormID a_what, Count a_count);
+
+    // applies what is pending now instead of at the next task queue run
+    void Flush();
+
+    // Flush if a pending move has a_loc or a_other on either side. does nothing on the thread that is flushing
+    void FlushIfTouches(RefID a_loc, RefID a_other = 0);
+
+    // drops what is pending, e.g. on load
+    void Cancel();
+
+    [[nodiscard]] Stats GetStats();
+
+private:
+    ContainerJournal() = default;
+
+    std::mutex flush_mutex_;  // one flush at a time, moves recorded later are applied later
+    static inline thread_local bool flushing_ = false;  // Manager::Update(moves) can raise events that land here
+    std::mutex mutex_;
+    Manager* manager_ = nullptr;
+    // arrival order, moves can depend on each other
+    std::vector<Manager::ItemMove> pending_;
+    std::unordered_set<RefID> locs_;  // both sides of everything in pending_
+    bool scheduled_ = false;
+    Stats stats_;
+};
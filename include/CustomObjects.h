@@ -1,4 +1,5 @@
 #pragma once
+#include "BasicStageInstance.h"
 #include "Utils.h"
 
 using Duration = float;
@@ -82,76 +83,24 @@ struct StageInstancePlain{
     FormID form_id=0; // for fake stuff
 };
 
-struct StageInstance {
-    float start_time; // start time of the stage
-    StageNo no;
-    Count count;
+struct StageInstance : BasicStageInstance<Types::FormEditorIDX> {
     //RefID location;  // RefID of the container where the fake food is stored or the real food itself when it is
                         // out in the world
-    Types::FormEditorIDX xtra;
 
     //StageInstance() : start_time(0), no(0), count(0), location(0) {}
-    StageInstance(const float st, const StageNo n, const Count c)
-        : start_time(st), no(n), count(c)
-    {
-        _elapsed = 0;
-        _delay_start = start_time;
-        _delay_mag = 1;
-        _delay_formid = 0;
-    }
+    using BasicStageInstance::BasicStageInstance;
         
     //define ==
     // assumes that they are in the same inventory
 	[[nodiscard]] bool operator==(const StageInstance& other) const;
 
-    // times are very close (abs diff less than 0.015h = 0.9min)
-    // assumes that they are in the same inventory
-	[[nodiscard]] bool AlmostSameExceptCount(const StageInstance& other, float curr_time) const;
-
-    StageInstance& operator=(const StageInstance& other);
-
     [[nodiscard]] RE::TESBoundObject* GetBound() const { return GetFormByID<RE::TESBoundObject>(xtra.form_id); };
 
-    [[nodiscard]] inline float GetElapsed(float curr_time) const;
-
-    [[nodiscard]] inline float GetDelaySlope() const;
-
-    void SetNewStart(float curr_time, float overshot);
-
-    void SetDelay(float time, float delay, FormID formid);
-
-    void SetTransform(float time, FormID formid);
-
-    [[nodiscard]] float GetTransformElapsed(const float curr_time) const { return GetElapsed(curr_time) - _elapsed; }
-
-    void RemoveTransform(float curr_time);
-
-    void RemoveTimeMod(float time);
-
-    [[nodiscard]] float GetDelayMagnitude() const { return GetDelaySlope(); }
-
-    [[nodiscard]] FormID GetDelayerFormID() const { return _delay_formid; }
-
-    [[nodiscard]] float GetHittingTime(const float schranke) const {
-        // _elapsed + dt*_delay_mag = schranke
-        return _delay_start + (schranke - _elapsed) / (GetDelaySlope() + std::numeric_limits<float>::epsilon());
-    }
-
-    [[nodiscard]] float GetTransformHittingTime(const float schranke) const{
-        if (!xtra.is_transforming) return 0;
-		return GetHittingTime(schranke+_elapsed);
-    }
+    using BasicStageInstance::SetDelay;
 
     [[nodiscard]] StageInstancePlain GetPlain() const;
 
     void SetDelay(const StageInstancePlain& plain);
-
-private:
-    float _elapsed; // y coord of the ausgangspunkt/elapsed time since the stage started
-    float _delay_start;  // x coord of the ausgangspunkt
-    float _delay_mag; // slope
-    FormID _delay_formid; // formid of the time modulator
-
 };
 
 struct StageUpdate {
@@ -1,9 +1,31 @@
 #pragma once
 #include <algorithm>
 #include "DynamicFormTracker.h"
+#include "Evolution.h"
+#include "InventorySnapshot.h"
+
+using SourceSlot = size_t;
+using ModulationInputs = Evolution::ModulationInputs;
+
+// gets notified by a Source about changes that its owner keeps indexes for
+class SourceListener {
+public:
+    virtual ~SourceListener() = default;
+
+    virtual void OnStageRegistered(SourceSlot a_slot, FormID a_stage_formid) = 0;
+    virtual void OnLocationAdded(SourceSlot a_slot, RefID a_loc) = 0;
+    virtual void OnLocationRemoved(SourceSlot a_slot, RefID a_loc) = 0;
+    // number of tracked instances (stage instance entries) changed by a_delta
+    virtual void OnInstanceCountChanged(SourceSlot a_slot, std::ptrdiff_t a_delta) = 0;
+    // stages and data were dropped (source failed and got reset)
+    virtual void OnSourceReset(SourceSlot a_slot) = 0;
+    // instances at a_loc were added, moved or changed
+    virtual void OnLocationChanged(SourceSlot a_slot, RefID a_loc) = 0;
+};
 
 struct Source {
     
+    using Instance = StageInstance;
     using SourceData = std::map<RefID,std::vector<StageInstance>>;
     using StageDict = std::map<StageNo, Stage>;
 
@@ -28,17 +50,36 @@ struct Source {
 
     [[nodiscard]] RE::TESBoundObject* GetBoundObject() const { return GetFormByID<RE::TESBoundObject>(formid, editorid); };
 
+    // registers the listener and replays the already registered stages and locations to it
+    void Attach(SourceListener* a_listener, SourceSlot a_slot);
+
+    [[nodiscard]] const std::unordered_map<FormID, StageNo>& GetStageFormIDs() const { return stage_formids; }
+
+    [[nodiscard]] size_t GetNInstances() const { return n_instances; }
+
+    // call after changing instances at loc from outside, so that the next CleanUpData looks at it
+    void MarkDirty(const RefID loc) {
+        dirty_locs.insert(loc);
+        if (listener) listener->OnLocationChanged(slot, loc);
+    }
+
     std::map<RefID,std::vector<StageUpdate>> UpdateAllStages(const std::vector<RefID>& filter, float time);
 
+    // UpdateAllStages for one instance at loc. appends its update to out, returns false if there is none
+    bool UpdateInstance(RefID loc, StageInstance& instance, float time, std::vector<StageUpdate>& out);
+
+    // if UpdateInstance would change the instance at time, without changing it
+    [[nodiscard]] bool WouldChange(const StageInstance& instance, float time);
+
     // daha once yaratilmis bi stage olmasi gerekiyo
-    bool IsStage(FormID some_formid);
+    [[nodiscard]] bool IsStage(FormID some_formid) const;
 
-    [[nodiscard]] inline bool IsStageNo(StageNo no) const;
+    [[nodiscard]] bool IsStageNo(const StageNo no) const { return stages.contains(no) || fake_stages.contains(no); }
 
-    [[nodiscard]] inline bool IsFakeStage(StageNo no) const;
+    [[nodiscard]] bool IsFakeStage(const StageNo no) const { return fake_stages.contains(no); }
 
     // assumes that the formid exists as a stage!
-    [[nodiscard]] StageNo GetStageNo(FormID formid_);
+    [[nodiscard]] StageNo GetStageNo(FormID formid_) const;
 
     const Stage& GetStage(StageNo no);
     [[nodiscard]] const Stage* GetStageSafe(StageNo no) const;
@@ -47,6 +88,9 @@ struct Source {
 
     [[nodiscard]] std::string GetStageName(StageNo no) const;
 
+    // interned editor id of the stage's form
+    EditorIDPool::ID GetStageEditorID(const Stage& stage);
+
     StageInstance* InsertNewInstance(const StageInstance& stage_instance, RefID loc);
 
     StageInstance* InitInsertInstanceWO(StageNo n, Count c, RefID l, Duration t_0);
@@ -63,22 +107,40 @@ struct Source {
 
     [[nodiscard]] bool IsDecayedItem(FormID _form_id) const;
 
-    FormID inline GetModulatorInInventory(RE::TESObjectREFR* inventory_owner) const;
+    FormID inline GetModulatorInInventory(InventorySnapshot& a_inventory) const;
 
     FormID inline GetModulatorInWorld(const RE::TESObjectREFR* wo) const;
 
-    inline FormID GetTransformerInInventory(RE::TESObjectREFR* inventory_owner) const;
+    inline FormID GetTransformerInInventory(InventorySnapshot& a_inventory) const;
 
     inline FormID GetTransformerInWorld(const RE::TESObjectREFR* wo) const;
 
-    // always update before doing this
-    void UpdateTimeModulationInInventory(RE::TESObjectREFR* inventory_owner, float _time);
+    void UpdateTimeModulationInWorld(RE::TESObjectREFR* wo, StageInstance& wo_inst, float _time);
 
-    void UpdateTimeModulationInWorld(RE::TESObjectREFR* wo, StageInstance& wo_inst, float _time) const;
+    // what the instances in the inventory get modulated with, see StepInventory
+    [[nodiscard]] ModulationInputs GetModulationInputs(const RE::TESObjectREFR* inventory_owner, InventorySnapshot& a_inventory) const;
+
+    // returns true if the instance changed
+    bool SetDelayOfInstance(StageInstance& instance, float a_time, const ModulationInputs& a_inputs) const;
 
     float GetNextUpdateTime(StageInstance* st_inst);
 
-    void CleanUpData();
+    // GetNextUpdateTime for every instance at loc, evaluated as one batch
+    void GetNextUpdateTimes(RefID loc, std::vector<float>& out);
+    // the same for the instances at every one of locs, in that order, as one batch
+    void GetNextUpdateTimes(const std::vector<RefID>& locs, std::vector<float>& out);
+
+    // locations with an instance whose next update is at or before a_time, from one batch over all locations
+    void GetLocationsDueBy(float a_time, std::vector<RefID>& out);
+
+    // a_deferred: location the caller cleans up itself (ShouldErase, FinishCleanUp). returns true if it was due
+    bool CleanUpData(RefID a_deferred = 0);
+
+    // the erase test of the clean up
+    [[nodiscard]] bool ShouldErase(const StageInstance& instance, float curr_time);
+
+    // after the caller of CleanUpData(loc) erased n_erased instances at loc
+    void FinishCleanUp(RefID loc, std::ptrdiff_t n_erased);
 
     void PrintData();
 
@@ -107,9 +169,43 @@ private:
     bool init_failed = false;
 
     StageDict stages;
+    std::unordered_map<FormID, StageNo> stage_formids;  // reverse lookup of stages
+    std::unordered_map<FormID, EditorIDPool::ID> stage_editorids;
 
-    // counta karismiyor
-    [[nodiscard]] bool UpdateStageInstance(StageInstance& st_inst, float curr_time);
+    // durations of stages 0..n-1 in one flat array, see StageMath. size() is GetNStages() as of the last
+    // BuildStageTable, read for every instance update
+    StageMath::Table stage_table;
+    void BuildStageTable();
+
+    SourceListener* listener = nullptr;
+    SourceSlot slot = 0;
+
+    size_t n_instances = 0;  // sum of the sizes of the vectors in data
+    void ChangeNInstances(std::ptrdiff_t delta);
+
+    // locations with changed instances since the last CleanUpData, and when the others are due because of what
+    // changes with time alone (forgetting decayed items, instances drifting together)
+    std::set<RefID> dirty_locs;
+    Evolution::CleanUpSchedule cleanup_schedule;
+    float last_cleanup = -1.f;
+
+    // the update, clean up and modulation rules live in Evolution.h, they use the members above
+    friend struct Evolution::Rules;
+
+    // CheckIntegrity is only rerun after stages or settings changed
+    uint32_t integrity_version = 0;
+    uint32_t integrity_checked_version = std::numeric_limits<uint32_t>::max();
+    bool integrity_ok = false;
+    void InvalidateIntegrity() { ++integrity_version; }
+    [[nodiscard]] bool CheckIntegrityCached();
+
+    // use these instead of touching the keys of data directly so that the listener stays in sync
+    std::vector<StageInstance>& GetOrAddLocation(RefID loc);
+    SourceData::iterator EraseLocation(SourceData::iterator it);
+
+    // what an instance that moved on to stage no or decayed shows as, for Evolution::Rules::UpdateStageInstance
+    void SetStageXtra(Types::FormEditorIDX& xtra, StageNo no);
+    void SetDecayedXtra(Types::FormEditorIDX& xtra);
 
     template <typename T>
     void ApplyMGEFFSettings(T* stage_form, std::vector<StageEffect>& settings_effs) {
@@ -163,22 +259,18 @@ private:
     }
 
     [[nodiscard]] size_t GetNStages() const;
-    
+
     [[nodiscard]] Stage GetFinalStage() const;
 
     [[nodiscard]] Stage GetTransformedStage(FormID key_formid) const;
 
-    void SetDelayOfInstances(float some_time, RE::TESObjectREFR* inventory_owner);
-
     void SetDelayOfInstance(StageInstance& instance, float curr_time, RE::TESObjectREFR* a_object, bool inventory_owner=true) const;
 
-    void SetDelayOfInstance(StageInstance& instance, float a_time, FormID a_transformer, FormID a_delayer, const std::vector<StageNo>&
+    bool SetDelayOfInstance(StageInstance& instance, float a_time, FormID a_transformer, FormID a_delayer, const std::vector<StageNo>&
                             allowed_stages) const;
    
     [[nodiscard]] bool CheckIntegrity();
 
-    float GetDecayTime(const StageInstance& st_inst);
-
     inline void InitFailed();
 
     void RegisterStage(FormID stage_formid, StageNo stage_no);
@@ -232,9 +324,6 @@ private:
     // also registers to stages
     FormID FetchFake(StageNo st_no);
 
-    StageNo GetLastStageNo();
-
+    // nearest loaded reference of one of the candidates that is close enough to a_obj, looked up in the ModulatorGrid
     static FormID SearchNearbyModulators(const RE::TESObjectREFR* a_obj, const std::vector<FormID>& candidates);
-
-    static void SearchModulatorInCell(FormID& result, const RE::TESObjectREFR* a_origin, const RE::TESObjectCELL* a_cell, const std::set<FormID>& modulators, float range=0);
 };
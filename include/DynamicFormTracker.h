@@ -11,8 +11,10 @@ struct ActEff {
 
 class DynamicFormTracker : public DFSaveLoadData {
     
+    using BaseKey = std::pair<FormID, EditorIDPool::ID>;  // base formid, interned base editorid
+
     // created form bank during the session. Create populates this.
-    std::map<std::pair<FormID, std::string>, std::set<FormID>> forms;
+    std::map<BaseKey, std::set<FormID>> forms;
     std::map<FormID, uint32_t> customIDforms; // Fetch populates this
 
     std::set<FormID> active_forms; // _yield populates this
@@ -80,7 +82,7 @@ class DynamicFormTracker : public DFSaveLoadData {
 		std::shared_lock lock(forms_mutex);
 		for (const auto& [base_pair, dyn_formset] : forms) {
 			if (dyn_formset.contains(dynamic_formid)) {
-				return GetFormByID(base_pair.first, base_pair.second);
+				return GetFormByID(base_pair.first, EditorIDPool::GetSingleton()->Resolve(base_pair.second));
 			}
 		}
 		return nullptr;
@@ -206,6 +208,8 @@ class DynamicFormTracker : public DFSaveLoadData {
 			return 0;
 		}
 
+        const BaseKey base_key = {base_formid, EditorIDPool::GetSingleton()->Intern(base_editorid)};
+
         RE::TESForm* new_form = nullptr;
 
         auto factory = RE::IFormFactory::GetFormFactoryByType(baseForm->GetFormType());
@@ -220,7 +224,7 @@ class DynamicFormTracker : public DFSaveLoadData {
         }
         logger::trace("Original form id: {:x}", new_form->GetFormID());
 
-        if (forms[{base_formid, base_editorid}].contains(setFormID)) {
+        if (forms[base_key].contains(setFormID)) {
         	logger::warn("Form with ID {:x} already exist for baseid {} and editorid {}.", setFormID, base_formid, base_editorid);
             ReviveDynamicForm(new_form, baseForm);
         } else ReviveDynamicForm(new_form, baseForm, setFormID);
@@ -230,10 +234,10 @@ class DynamicFormTracker : public DFSaveLoadData {
         logger::trace("Created form with type: {}, Base ID: {:x}, Name: {}",
                       RE::FormTypeToString(new_form->GetFormType()), new_form->GetFormID(),new_form->GetName());
 
-        if (auto lock = std::unique_lock(forms_mutex); !forms[{base_formid, base_editorid}].insert(new_formid).second) {
+        if (auto lock = std::unique_lock(forms_mutex); !forms[base_key].insert(new_formid).second) {
             lock.unlock();
             logger::error("Failed to insert new form into forms.");
-            if (!_delete({base_formid, base_editorid}, new_formid) && !deleted_forms.contains(new_formid)) {
+            if (!_delete(base_key, new_formid) && !deleted_forms.contains(new_formid)) {
                 logger::critical("Failed to delete form with ID {:x}.", new_formid);
             }
             return 0;
@@ -242,7 +246,7 @@ class DynamicFormTracker : public DFSaveLoadData {
         if (new_formid >= 0xFF3DFFFF){
             logger::critical("Dynamic FormID limit reached!!!!!!");
             block_create = true;
-            if (!_delete({base_formid, base_editorid}, new_formid) && !deleted_forms.contains(new_formid)) {
+            if (!_delete(base_key, new_formid) && !deleted_forms.contains(new_formid)) {
                 logger::critical("Failed to delete form with ID {:x}.", new_formid);
             }
 			return 0;
@@ -285,7 +289,7 @@ class DynamicFormTracker : public DFSaveLoadData {
 		return nullptr;
 	}
 
-    bool _delete(const std::pair<FormID, std::string>& base, const FormID dynamic_formid) {
+    bool _delete(const BaseKey& base, const FormID dynamic_formid) {
         if (auto lock = std::shared_lock(protected_forms_mutex); protected_forms.contains(dynamic_formid)) {
 			logger::warn("Form with ID {:x} is protected.", dynamic_formid);
 			return false;
@@ -432,7 +436,9 @@ public:
                 return {};
             }
         }
-        const std::pair key = {base_formid, base_editorid};
+        const auto editorid = EditorIDPool::GetSingleton()->Find(base_editorid);
+        if (!editorid) return {};
+        const BaseKey key = {base_formid, editorid};
         if (auto lock = std::shared_lock(forms_mutex); forms.contains(key)) return forms.at(key);
         return {};
     }
@@ -460,8 +466,8 @@ public:
     std::vector<std::pair<FormID, std::string>> GetSourceForms(){
         std::set<std::pair<FormID, std::string>> source_forms;
 		std::shared_lock lock(forms_mutex);
-		for (const auto& base : forms | std::views::keys) {
-			source_forms.insert(base);
+		for (const auto& [base_formid, base_editorid] : forms | std::views::keys) {
+			source_forms.insert({base_formid, EditorIDPool::GetSingleton()->Resolve(base_editorid)});
 		}
 		lock.unlock();
 		std::shared_lock lock2(act_effs_mutex);
@@ -562,7 +568,7 @@ public:
 
     [[maybe_unused]] void ReviveAll() {
         for (const auto& [base, formset] : forms) {
-            auto* base_form = GetFormByID(base.first, base.second);
+            auto* base_form = GetFormByID(base.first, EditorIDPool::GetSingleton()->Resolve(base.second));
             if (!base_form) {
                 logger::error("Failed to get base form.");
                 continue;
@@ -595,7 +601,7 @@ public:
         ReviveDynamicForm(form, base_form);
 		std::unique_lock lock(protected_forms_mutex);
 		std::unique_lock lock2(forms_mutex);
-        forms[{baseID, baseEditorID}].insert(dynamic_formid);
+        forms[{baseID, EditorIDPool::GetSingleton()->Intern(baseEditorID)}].insert(dynamic_formid);
         protected_forms.insert(dynamic_formid);
 	}
 
@@ -641,7 +647,7 @@ public:
 
         int n_fakes = 0;
         for (const auto& [base_pair, dyn_formset] : forms) {
-            const DFSaveDataLHS lhs({base_pair.first, base_pair.second});
+            const DFSaveDataLHS lhs({base_pair.first, EditorIDPool::GetSingleton()->Resolve(base_pair.second)});
             DFSaveDataRHS rhs;
 			for (const auto dyn_formid : dyn_formset) {
                 if (!IsActive(dyn_formid) && !IsProtected(dyn_formid)) logger::info("Inactive form {:x} found in forms set.",dyn_formid);
@@ -699,12 +705,13 @@ public:
                     continue;
                 }
 
-                if (auto lock = std::unique_lock(forms_mutex); forms.contains({base_formid, base_editorid}) &&
-                    forms.at({base_formid, base_editorid}).contains(dyn_formid)) {
+                const BaseKey base_key = {base_formid, EditorIDPool::GetSingleton()->Intern(base_editorid)};
+                if (auto lock = std::unique_lock(forms_mutex); forms.contains(base_key) &&
+                    forms.at(base_key).contains(dyn_formid)) {
                     logger::trace("Form with ID {:x} already exist for baseid {} and editorid {}.", dyn_formid,
                                  base_formid, base_editorid);
                 }
-				else if (!forms[{base_formid, base_editorid}].insert(dyn_formid).second) {
+				else if (!forms[base_key].insert(dyn_formid).second) {
 					logger::error("Failed to insert new form into forms.");
 					continue;
 				}
@@ -747,7 +754,7 @@ public:
     void Print() {
 		std::shared_lock lock(forms_mutex);
         for (const auto& [base, formset] : forms) {
-			logger::info("---------------------Base formid: {:x}, EditorID: {}---------------------", base.first, base.second);
+			logger::info("---------------------Base formid: {:x}, EditorID: {}---------------------", base.first, EditorIDPool::GetSingleton()->Resolve(base.second));
 			for (const auto _formid : formset) {
 				logger::info("Dynamic formid: {:x} with name: {}", _formid, GetFormByID(_formid)->GetName());
 			}
@@ -10,7 +10,9 @@ class OurEventSink final : public RE::BSTEventSink<RE::TESEquipEvent>,
                            public RE::BSTEventSink<RE::TESSleepStopEvent>,
                            public RE::BSTEventSink<RE::TESWaitStopEvent>,
                            public RE::BSTEventSink<RE::BGSActorCellEvent>,
-                           public RE::BSTEventSink<RE::TESFormDeleteEvent> {
+                           public RE::BSTEventSink<RE::TESFormDeleteEvent>,
+                           public RE::BSTEventSink<RE::TESCellAttachDetachEvent>,
+                           public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
 
     OurEventSink() = default;
     OurEventSink(const OurEventSink&) = delete;
@@ -27,6 +29,10 @@ class OurEventSink final : public RE::BSTEventSink<RE::TESEquipEvent>,
     RefID picked_up_refid;
 
     bool furniture_entered = false;
+    float time_jump_start = 0.f;  // game time when the sleep/wait menu opened, 0 if it is not open
+
+    // sleep and wait stop: one time jump from time_jump_start if we saw the menu open, otherwise a cell scan
+    void HandleTimeJump();
     RE::NiPointer<RE::TESObjectREFR> furniture = nullptr;
 
 	/*const float min_last_crosshair_update_time = 0.0003f;
@@ -76,4 +82,11 @@ public:
 
     RE::BSEventNotifyControl ProcessEvent(const RE::TESFormDeleteEvent* a_event,
                                           RE::BSTEventSource<RE::TESFormDeleteEvent>*) override;
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* a_event,
+                                          RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override;
+
+    // feeds the ModulatorGrid
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESCellAttachDetachEvent* a_event,
+                                          RE::BSTEventSource<RE::TESCellAttachDetachEvent>*) override;
 };
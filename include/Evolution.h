@@ -0,0 +1,380 @@
+#pragma once
+#include "HittingTimes.h"
+#include "InstanceOps.h"
+#include "StageMath.h"
+
+// How the instances of a source evolve, without the game. Source calls these on itself and the headless tests on the
+// stand-in in tests/ModelWorld.h, so test_catch_up and test_time_jump check the rules the plugin runs.
+// Src has
+//   Instance                                    a BasicStageInstance
+//   data                                        location -> instances
+//   stage_table, decayed_stage, transformed_stages (transformer -> stage)
+//   settings.transformers (transformer -> result, duration, allowed stages), settings.delayers, settings.decayed_id
+//   dirty_locs, cleanup_schedule, last_cleanup
+//   IsStageNo(no), IsFakeStage(no), GetStage(no)  a stage has formid and duration
+//   SetStageXtra(xtra, no), SetDecayedXtra(xtra)  what an instance shows as in stage no or once it decayed
+//   MarkDirty(loc), ChangeNInstances(delta), EraseLocation(it)
+namespace Evolution {
+
+    // what the modulation sets the instances at a location to, see Source::GetModulationInputs
+    struct ModulationInputs {
+        bool freeze = false;
+        FormID transformer = 0;
+        FormID delayer = 0;
+        const std::vector<StageMath::No>* allowed_stages = nullptr;  // of the transformer, in the settings of the source
+
+        bool operator==(const ModulationInputs&) const = default;
+    };
+
+    // what HittingTimes::Evaluate reads, one row per instance, see Rules::GatherHittingInputs.
+    // has_next is 0 for the rows that never reach their next update
+    struct HittingInputs {
+        std::vector<float> elapsed;
+        std::vector<float> delay_start;
+        std::vector<float> delay_mag;
+        std::vector<float> schranke;
+        std::vector<uint8_t> has_next;
+
+        void clear() {
+            elapsed.clear();
+            delay_start.clear();
+            delay_mag.clear();
+            schranke.clear();
+            has_next.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return elapsed.size(); }
+
+        void Evaluate(std::vector<float>& out) const {
+            out.resize(size());
+            HittingTimes::Evaluate(delay_start.data(), elapsed.data(), delay_mag.data(), schranke.data(), out.data(), size());
+            for (size_t i = 0; i < out.size(); ++i) {
+                if (!has_next[i]) out[i] = 0;
+            }
+        }
+    };
+
+    // when the locations that nothing changes are due for a clean up again, see Rules::NextCleanUpTime
+    class CleanUpSchedule {
+    public:
+        // inf: never
+        void Set(const RefID loc, const float time) {
+            Remove(loc);
+            if (!(time < std::numeric_limits<float>::infinity())) return;
+            by_time_.emplace(time, loc);
+            times_.emplace(loc, time);
+        }
+
+        void Remove(const RefID loc) {
+            if (const auto it = times_.find(loc); it != times_.end()) {
+                by_time_.erase({it->second, loc});
+                times_.erase(it);
+            }
+        }
+
+        // moves the locations due by a_time to a_out
+        void PopDue(const float a_time, std::set<RefID>& a_out) {
+            while (!by_time_.empty() && by_time_.begin()->first <= a_time) {
+                const auto loc = by_time_.begin()->second;
+                a_out.insert(loc);
+                times_.erase(loc);
+                by_time_.erase(by_time_.begin());
+            }
+        }
+
+        void clear() {
+            by_time_.clear();
+            times_.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return times_.size(); }
+
+        bool operator==(const CleanUpSchedule&) const = default;
+
+    private:
+        std::set<std::pair<float, RefID>> by_time_;
+        std::map<RefID, float> times_;
+    };
+
+    struct Rules {
+        // the schedule is this early (game hours), so that float rounding can't make it late
+        static constexpr float cleanup_margin = 0.01f;
+
+        // counta karismiyor
+        template <typename Src>
+        static bool UpdateStageInstance(Src& src, typename Src::Instance& st_inst, const float curr_time) {
+            if (st_inst.xtra.is_decayed) return false;  // decayed
+            if (st_inst.xtra.is_transforming) {
+                const auto transformer_form_id = st_inst.GetDelayerFormID();
+                if (const auto it = src.settings.transformers.find(transformer_form_id); it == src.settings.transformers.end()) {
+                    logger::error("Transformer Formid {} not found in default settings.", transformer_form_id);
+                    st_inst.RemoveTransform(curr_time);
+                }
+                else {
+                    const auto trnsfrm_duration = std::get<1>(it->second);
+                    if (const auto trnsfrm_elapsed = st_inst.GetTransformElapsed(curr_time); trnsfrm_elapsed >= trnsfrm_duration) {
+                        const auto& transformed_stage = src.transformed_stages[transformer_form_id];
+                        st_inst.xtra.form_id = transformed_stage.formid;
+                        st_inst.SetNewStart(curr_time, trnsfrm_elapsed - trnsfrm_duration);
+                        return true;
+                    }
+                    return false;
+                }
+            }
+            else if (src.stage_table.size() < 2 && src.settings.decayed_id == st_inst.xtra.form_id) {
+                st_inst.SetNewStart(curr_time, 0);
+                return false;
+            }
+            if (!src.IsStageNo(st_inst.no)) return false;
+            if (st_inst.count <= 0) return false;
+            float diff = st_inst.GetElapsed(curr_time);
+            bool updated = false;
+
+            while (diff < 0) {
+                if (st_inst.no > 0) {
+                    if (!src.IsStageNo(st_inst.no - 1)) {
+                        logger::critical("Stage {} does not exist.", st_inst.no - 1);
+                        return false;
+                    }
+                    st_inst.no--;
+                    diff += src.GetStage(st_inst.no).duration;
+                    updated = true;
+                }
+                else {
+                    diff = 0;
+                    break;
+                }
+            }
+            // walk the flat durations instead of looking every stage up
+            if (const auto next = StageMath::Forward(src.stage_table, st_inst.no, diff); next.no != st_inst.no) {
+                st_inst.no = next.no;
+                diff = next.diff;
+                updated = true;
+                if (!src.IsStageNo(st_inst.no)) st_inst.xtra.is_decayed = true;
+            }
+            if (updated) {
+                if (st_inst.xtra.is_decayed) src.SetDecayedXtra(st_inst.xtra);
+                else src.SetStageXtra(st_inst.xtra, st_inst.no);
+                // as long as the delay start was before the ueberschreitung time this will work,
+                // the delay start cant be strictly after the ueberschreitung time bcs we call update when a new delay
+                // starts so the delay start will always be before the ueberschreitung time
+                st_inst.SetNewStart(curr_time, diff);
+            }
+            return updated;
+        }
+
+        // UpdateAllStages for one instance at loc. appends its update to out, returns false if there is none
+        template <typename Src, typename Update>
+        static bool UpdateInstance(Src& src, const RefID loc, typename Src::Instance& instance, const float time,
+                                   std::vector<Update>& out) {
+            // most instances are still in their stage, only look the old stage up for the ones that moved on
+            const auto old_no = instance.no;
+            if (!UpdateStageInstance(src, instance, time)) return false;
+            const auto* old_stage = src.IsStageNo(old_no) ? &src.GetStage(old_no) : nullptr;
+            src.MarkDirty(loc);
+            decltype(old_stage) new_stage = nullptr;
+            if (instance.xtra.is_transforming) {
+                instance.xtra.is_decayed = true;
+                instance.xtra.is_fake = false;
+                const auto it = src.transformed_stages.find(instance.GetDelayerFormID());
+                if (it == src.transformed_stages.end()) {
+                    logger::error("Transformed stage not found.");
+                    return false;
+                }
+                new_stage = &it->second;
+                instance.xtra.is_transforming = false;
+            }
+            else if (instance.xtra.is_decayed || !src.IsStageNo(instance.no)) {
+                new_stage = &src.decayed_stage;
+            }
+            out.emplace_back(old_stage, new_stage ? new_stage : &src.GetStage(instance.no), instance.count, instance.start_time,
+                             src.IsFakeStage(instance.no));
+            return true;
+        }
+
+        // if UpdateInstance would change the instance at time, without changing it
+        template <typename Src>
+        static bool WouldChange(Src& src, const typename Src::Instance& instance, const float time) {
+            auto copy = instance;
+            return UpdateStageInstance(src, copy, time) || !copy.Identical(instance);
+        }
+
+        template <typename Src>
+        static float GetNextUpdateTime(Src& src, const typename Src::Instance& st_inst) {
+            if (st_inst.xtra.is_decayed) return 0;
+            if (!src.IsStageNo(st_inst.no)) {
+                logger::error("Stage {} does not exist.", st_inst.no);
+                return 0;
+            }
+
+            const auto delay_slope = st_inst.GetDelaySlope();
+            if (std::abs(delay_slope) < EPSILON) return 0;
+
+            if (st_inst.xtra.is_transforming) {
+                const auto it = src.settings.transformers.find(st_inst.GetDelayerFormID());
+                if (it == src.settings.transformers.end()) return 0.0f;
+                return st_inst.GetTransformHittingTime(std::get<1>(it->second));
+            }
+
+            const auto schranke = delay_slope > 0 ? src.GetStage(st_inst.no).duration : 0.f;
+            return st_inst.GetHittingTime(schranke);
+        }
+
+        // appends a row for each of the instances
+        template <typename Src>
+        static void GatherHittingInputs(Src& src, const std::vector<typename Src::Instance>& instances, HittingInputs& inputs) {
+            for (const auto& st_inst : instances) {
+                inputs.elapsed.push_back(st_inst._elapsed);
+                inputs.delay_start.push_back(st_inst._delay_start);
+                inputs.delay_mag.push_back(st_inst._delay_mag);
+                auto& schranke = inputs.schranke.emplace_back(0.f);
+                auto& has_next = inputs.has_next.emplace_back(0);
+
+                // the same cases as in GetNextUpdateTime
+                if (st_inst.xtra.is_decayed || !src.IsStageNo(st_inst.no)) continue;
+                const auto delay_slope = st_inst.GetDelaySlope();
+                if (std::abs(delay_slope) < EPSILON) continue;
+                if (st_inst.xtra.is_transforming) {
+                    const auto it = src.settings.transformers.find(st_inst.GetDelayerFormID());
+                    if (it == src.settings.transformers.end()) continue;
+                    schranke = std::get<1>(it->second) + st_inst._elapsed;
+                }
+                else if (delay_slope > 0) schranke = src.GetStage(st_inst.no).duration;
+                has_next = 1;
+            }
+        }
+
+        // GetNextUpdateTime for the instances at every one of locs, in that order, as one batch
+        template <typename Src>
+        static void GetNextUpdateTimes(Src& src, const std::vector<RefID>& locs, std::vector<float>& out) {
+            static thread_local HittingInputs inputs;
+            inputs.clear();
+            for (const auto loc : locs) {
+                const auto it = src.data.find(loc);
+                if (it == src.data.end()) continue;
+                GatherHittingInputs(src, it->second, inputs);
+            }
+            inputs.Evaluate(out);
+        }
+
+        template <typename Src>
+        static float GetDecayTime(const Src& src, const typename Src::Instance& st_inst) {
+            if (const auto slope = st_inst.GetDelaySlope(); slope <= 0) return -1;
+            if (!src.IsStageNo(st_inst.no)) {
+                logger::error("Stage {} does not exist.", st_inst.no);
+                return true;
+            }
+            return st_inst.GetHittingTime(StageMath::Remaining(src.stage_table, st_inst.no));
+        }
+
+        // the erase test of the clean up
+        template <typename Src>
+        static bool ShouldErase(const Src& src, const typename Src::Instance& instance, const float curr_time,
+                                const float forgetting_time) {
+            if (instance.count <= 0 || instance.start_time > curr_time || instance.xtra.is_decayed || !src.IsStageNo(instance.no)) {
+                return true;
+            }
+            const auto decay_time = GetDecayTime(src, instance);
+            return decay_time > 0.f && curr_time - decay_time > forgetting_time;
+        }
+
+        // returns true if the location is empty afterwards
+        template <typename Src>
+        static bool CleanUpLocation(const Src& src, std::vector<typename Src::Instance>& instances, const float curr_time,
+                                    const float forgetting_time, std::ptrdiff_t& n_erased) {
+            InstanceOps::MergeAlmostSame(instances, curr_time);
+            n_erased += std::erase_if(instances, [&](const auto& inst) { return ShouldErase(src, inst, curr_time, forgetting_time); });
+            return instances.empty();
+        }
+
+        // the earliest time from curr_time on at which CleanUpLocation could change instances it just cleaned up if
+        // nothing else touches them: a decayed one is forgotten or two drift together. inf if never
+        template <typename Src>
+        static float NextCleanUpTime(const Src& src, const std::vector<typename Src::Instance>& instances,
+                                     const float curr_time, const float forgetting_time) {
+            auto next = InstanceOps::NextMergeTime(instances, curr_time, cleanup_margin);
+            for (const auto& inst : instances) {
+                if (const auto decay_time = GetDecayTime(src, inst); decay_time > 0.f) {
+                    next = std::min(next, decay_time + forgetting_time - cleanup_margin);
+                }
+            }
+            return next;
+        }
+
+        // the dirty locations and the ones the schedule has due by now. all of them the first time and when the clock
+        // went back, the schedule only holds going forward.
+        // a_deferred: location the caller cleans up itself (ShouldErase, FinishCleanUp). returns true if it was due
+        template <typename Src>
+        static bool CleanUpData(Src& src, const float curr_time, const float forgetting_time, const RefID a_deferred) {
+            if (src.data.empty()) return false;
+            std::ptrdiff_t n_erased = 0;
+            bool deferred_due = false;
+            const auto clean = [&](const auto it) {
+                if (CleanUpLocation(src, it->second, curr_time, forgetting_time, n_erased)) return src.EraseLocation(it);
+                src.cleanup_schedule.Set(it->first, NextCleanUpTime(src, it->second, curr_time, forgetting_time));
+                return std::next(it);
+            };
+            if (src.last_cleanup < 0.f || curr_time < src.last_cleanup) {
+                for (auto it = src.data.begin(); it != src.data.end();) {
+                    if (it->first == a_deferred) {
+                        deferred_due = true;
+                        ++it;
+                    }
+                    else it = clean(it);
+                }
+            }
+            else {
+                src.cleanup_schedule.PopDue(curr_time, src.dirty_locs);
+                for (const auto loc : src.dirty_locs) {
+                    const auto it = src.data.find(loc);
+                    if (it == src.data.end()) continue;
+                    if (loc == a_deferred) deferred_due = true;
+                    else clean(it);
+                }
+            }
+            src.last_cleanup = curr_time;
+            src.dirty_locs.clear();
+            src.ChangeNInstances(-n_erased);
+            return deferred_due;
+        }
+
+        // after the caller of CleanUpData(loc) erased n_erased instances at loc
+        template <typename Src>
+        static void FinishCleanUp(Src& src, const RefID loc, const std::ptrdiff_t n_erased, const float curr_time,
+                                  const float forgetting_time) {
+            if (const auto it = src.data.find(loc); it != src.data.end()) {
+                if (it->second.empty()) src.EraseLocation(it);
+                else src.cleanup_schedule.Set(loc, NextCleanUpTime(src, it->second, curr_time, forgetting_time));
+            }
+            src.ChangeNInstances(-n_erased);
+        }
+
+        // returns true if the instance changed
+        template <typename Src>
+        static bool SetDelayOfInstance(const Src& src, typename Src::Instance& instance, const float a_time,
+                                       const FormID a_transformer, const FormID a_delayer,
+                                       const std::vector<StageMath::No>& allowed_stages) {
+            bool changed = false;
+            if (!a_transformer || std::ranges::find(allowed_stages, instance.no) == allowed_stages.end()) {
+                changed = instance.RemoveTransform(a_time);
+            }
+            else return instance.SetTransform(a_time, a_transformer);
+
+            const auto it = src.settings.delayers.find(a_delayer);
+            const float delay_ = !a_delayer || it == src.settings.delayers.end() ? 1.f : it->second;
+            return instance.SetDelay(a_time, delay_, a_delayer) || changed;
+        }
+
+        template <typename Src>
+        static bool SetDelayOfInstance(const Src& src, typename Src::Instance& instance, const float a_time,
+                                       const ModulationInputs& a_inputs) {
+            if (a_inputs.freeze) {
+                const bool removed = instance.RemoveTimeMod(a_time);
+                return instance.SetDelay(a_time, 0, 0) || removed;
+            }
+            static const std::vector<StageMath::No> no_stages;
+            return SetDelayOfInstance(src, instance, a_time, a_inputs.transformer, a_inputs.delayer,
+                                      a_inputs.allowed_stages ? *a_inputs.allowed_stages : no_stages);
+        }
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+// Batch versions of the StageInstance time math over plain float arrays.
+// Uses AVX or SSE depending on what the CPU supports, with a scalar loop for the rest. Knows nothing about the game.
+namespace HittingTimes {
+    enum class SimdLevel { kScalar, kSSE, kAVX };
+
+    // out[i] = delay_start[i] + (schranke[i] - elapsed[i]) / (slope(delay_mag[i]) + eps), same as StageInstance::GetHittingTime
+    void Evaluate(const float* delay_start, const float* elapsed, const float* delay_mag, const float* schranke,
+                  float* out, size_t n);
+    // with a given level instead of the detected one, capped at what the CPU has. for tests and benchmarks
+    void Evaluate(SimdLevel a_level, const float* delay_start, const float* elapsed, const float* delay_mag,
+                  const float* schranke, float* out, size_t n);
+
+    // due[i] = times[i] <= curr_time
+    void FlagDue(const float* times, float curr_time, uint8_t* due, size_t n);
+
+    // best level the CPU and OS support, detected once
+    [[nodiscard]] SimdLevel GetSimdLevel();
+    [[nodiscard]] const char* GetSimdLevelName(SimdLevel a_level);
+    [[nodiscard]] const char* GetSimdLevelName();
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+// Algorithms over the instance vector of one location. Templated on the instance type so they don't need the game,
+// StageInstance is the only one the plugin uses. The tests run them on a stand-in with the same members.
+namespace InstanceOps {
+
+    // AlmostSameExceptCount never matches start times this far apart
+    inline constexpr double merge_window = 0.015;
+    // nor elapsed times
+    inline constexpr double merge_threshold = 0.015;
+    // below this the pairwise loop is cheaper than sorting (bench_merge_almost_same puts the crossover at 20-40)
+    inline constexpr size_t small_location = 32;
+
+    // adds the count of every later instance that is AlmostSameExceptCount to the earlier one and zeroes it.
+    // same result as comparing every pair in order, but only instances with the same stage and form can be almost same
+    // and they have to start within merge_window of each other. so each one only looks at its neighbours in start time
+    template <typename Instance>
+    void MergeAlmostSame(std::vector<Instance>& instances, const float curr_time) {
+        const auto n = instances.size();
+        if (n < 2) return;
+        if (n <= small_location) {
+            for (size_t i = 0; i + 1 < n; ++i) {
+                for (size_t j = i + 1; j < n; ++j) {
+                    if (instances[j].count > 0 && instances[i].AlmostSameExceptCount(instances[j], curr_time)) {
+                        instances[i].count += instances[j].count;
+                        instances[j].count = 0;
+                    }
+                }
+            }
+            return;
+        }
+        static thread_local std::vector<size_t> order;
+        static thread_local std::vector<size_t> pos;
+        order.resize(n);
+        pos.resize(n);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::sort(order, [&instances](const size_t a, const size_t b) {
+            const auto& x = instances[a];
+            const auto& y = instances[b];
+            return std::tie(x.no, x.xtra.form_id, x.start_time) < std::tie(y.no, y.xtra.form_id, y.start_time);
+        });
+        for (size_t k = 0; k < n; ++k) pos[order[k]] = k;
+
+        // false once we are out of the window of i
+        const auto visit = [&instances, curr_time](const size_t i, const size_t j) {
+            auto& inst = instances[i];
+            auto& other = instances[j];
+            if (inst.no != other.no || inst.xtra.form_id != other.xtra.form_id ||
+                std::abs(inst.start_time - other.start_time) >= merge_window) return false;
+            // only into earlier instances, as the pairwise loop did
+            if (j > i && other.count > 0 && inst.AlmostSameExceptCount(other, curr_time)) {
+                inst.count += other.count;
+                other.count = 0;
+            }
+            return true;
+        };
+
+        for (size_t i = 0; i + 1 < n; ++i) {
+            for (auto k = pos[i]; k-- > 0 && visit(i, order[k]);) {}
+            for (auto k = pos[i] + 1; k < n && visit(i, order[k]); ++k) {}
+        }
+    }
+
+    // earliest time from curr_time on at which two instances MergeAlmostSame left apart could be almost same, inf if
+    // never. only start times are compared otherwise, so it is when their elapsed times drift into merge_threshold,
+    // and that takes different slopes. a_margin (hours) early, and curr_time for a pair that is that close already:
+    // float rounding can tip those either way
+    template <typename Instance>
+    float NextMergeTime(const std::vector<Instance>& instances, const float curr_time, const double a_margin) {
+        constexpr auto never = std::numeric_limits<float>::infinity();
+        const auto n = instances.size();
+        if (n < 2) return never;
+        static thread_local std::vector<size_t> order;
+        order.resize(n);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::sort(order, [&instances](const size_t a, const size_t b) {
+            const auto& x = instances[a];
+            const auto& y = instances[b];
+            return std::tie(x.no, x.xtra.form_id, x.start_time) < std::tie(y.no, y.xtra.form_id, y.start_time);
+        });
+        // GetElapsed stands still below EPSILON
+        const auto slope = [](const Instance& inst) -> double {
+            const auto s = inst.GetDelaySlope();
+            return std::fabs(s) < EPSILON ? 0. : s;
+        };
+
+        double earliest = never;
+        for (size_t k = 0; k + 1 < n; ++k) {
+            const auto& inst = instances[order[k]];
+            for (auto m = k + 1; m < n; ++m) {
+                const auto& other = instances[order[m]];
+                if (inst.no != other.no || inst.xtra.form_id != other.xtra.form_id ||
+                    std::abs(inst.start_time - other.start_time) >= merge_window) break;
+                if (!(inst.xtra == other.xtra)) continue;
+                const double diff = static_cast<double>(inst.GetElapsed(curr_time)) - other.GetElapsed(curr_time);
+                const double gap = std::abs(diff) - merge_threshold - a_margin;
+                if (gap < 0) return curr_time;
+                // closing in only if the one ahead is slower
+                const double closing = diff > 0 ? slope(other) - slope(inst) : slope(inst) - slope(other);
+                if (closing > 0) earliest = std::min(earliest, curr_time + gap / closing);
+            }
+        }
+        return static_cast<float>(earliest);
+    }
+
+    template <typename Instance>
+    struct Taken {
+        bool found = false;           // there was an instance of the form
+        size_t n_whole = 0;           // instances that were taken whole
+        Instance* split = nullptr;    // the one that was only partly needed, still in the vector with the rest of its count
+        decltype(Instance::count) count = 0;  // taken of split, or what could not be taken if there is no split
+    };
+
+    // the vector part of Source::MoveInstances: takes a_count of the instances of a_form, the ones with the most elapsed
+    // time first if a_older_first. a_sink(n) gives the vector the whole ones go to (nullptr to drop them), it is only
+    // called if there are any. they are appended in the order they were taken and leave a_from in one compaction
+    template <typename Instance, typename Form, typename Count, typename Sink>
+    Taken<Instance> Take(std::vector<Instance>& a_from, const Form a_form, Count a_count, const bool a_older_first,
+                         const float a_curr_time, Sink&& a_sink) {
+        Taken<Instance> result{.count = a_count};
+        // (elapsed, index) of the instances of the form, ages computed once instead of in every comparison
+        static thread_local std::vector<std::pair<float, size_t>> candidates;
+        candidates.clear();
+        for (size_t i = 0; i < a_from.size(); ++i) {
+            if (a_from[i].xtra.form_id == a_form) candidates.emplace_back(a_from[i].GetElapsed(a_curr_time), i);
+        }
+        if (candidates.empty()) return result;
+        result.found = true;
+
+        if (a_older_first) std::ranges::stable_sort(candidates, std::greater{}, &std::pair<float, size_t>::first);
+        else std::ranges::stable_sort(candidates, std::less{}, &std::pair<float, size_t>::first);
+
+        // whole instances are only flagged here and go out in one erase at the end, indices stay valid meanwhile
+        static thread_local std::vector<uint8_t> taken;
+        taken.assign(a_from.size(), 0);
+        for (const auto index : candidates | std::views::values) {
+            if (!a_count) break;
+            auto& instance = a_from[index];
+            if (a_count <= instance.count) {
+                instance.count -= a_count;
+                result.split = &instance;
+                break;
+            }
+            a_count -= instance.count;
+            taken[index] = 1;
+            ++result.n_whole;
+        }
+        result.count = a_count;
+        if (!result.n_whole) return result;
+
+        if (std::vector<Instance>* to = a_sink(result.n_whole)) {
+            to->reserve(to->size() + result.n_whole);
+            for (const auto index : candidates | std::views::values) {
+                if (taken[index]) to->push_back(a_from[index]);
+            }
+        }
+        size_t write = 0;
+        for (size_t read = 0; read < a_from.size(); ++read) {
+            if (taken[read]) continue;
+            if (write != read) a_from[write] = std::move(a_from[read]);
+            if (result.split == &a_from[read]) result.split = &a_from[write];
+            ++write;
+        }
+        a_from.erase(a_from.begin() + static_cast<std::ptrdiff_t>(write), a_from.end());
+        return result;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// Inventory of one reference, built on first use and reused until we change that inventory ourselves.
+// References returned by Get() are only valid until the next Invalidate().
+class InventorySnapshot {
+public:
+    using ItemMap = RE::TESObjectREFR::InventoryItemMap;
+
+    explicit InventorySnapshot(RE::TESObjectREFR* a_owner) : owner_(a_owner) {}
+
+    [[nodiscard]] RE::TESObjectREFR* GetOwner() const { return owner_; }
+
+    const ItemMap& Get() {
+        ++n_requests_;
+        if (!valid_) {
+            inventory_ = owner_->GetInventory();
+            valid_ = true;
+            ++n_built_;
+        }
+        return inventory_;
+    }
+
+    // call after adding or removing items of the owner
+    void Invalidate() { valid_ = false; }
+
+    // how many times GetInventory was actually called, and how many times it was asked for
+    [[nodiscard]] static uint64_t GetNBuilt() { return n_built_; }
+    [[nodiscard]] static uint64_t GetNRequests() { return n_requests_; }
+
+private:
+    RE::TESObjectREFR* owner_;
+    ItemMap inventory_;
+    bool valid_ = false;
+
+    static inline std::atomic<uint64_t> n_built_ = 0;
+    static inline std::atomic<uint64_t> n_requests_ = 0;
+};
@@ -1,8 +1,11 @@
 #pragma once
 #include "Data.h"
+#include "SlotMap.h"
+#include "Snapshot.h"
+#include "TouchStamps.h"
 #include "Ticker.h"
 
-class Manager final : public Ticker, public SaveLoadData {
+class Manager final : public Ticker, public SaveLoadData, public SourceListener {
 	RE::TESObjectREFR* player_ref = RE::PlayerCharacter::GetSingleton()->As<RE::TESObjectREFR>();
 	
     std::map<Types::FormFormID, std::pair<int, Count>> handle_crafting_instances;  // formid1: source formid, formid2: stage formid
@@ -18,28 +21,123 @@ class Manager final : public Ticker, public SaveLoadData {
     std::shared_mutex sourceMutex_;
     std::shared_mutex queueMutex_;
 
-    std::vector<Source> sources;
+    SlotMap<Source> sources;  // addresses stay valid while new sources get added
+    std::unordered_map<FormID, SourceSlot> stage_index_;  // stage formid -> owning source
+    std::unordered_map<RefID, std::vector<SourceSlot>> location_index_;  // location -> sources with data there (sorted)
+
+    void OnStageRegistered(SourceSlot a_slot, FormID a_stage_formid) override;
+    void OnLocationAdded(SourceSlot a_slot, RefID a_loc) override;
+    void OnLocationRemoved(SourceSlot a_slot, RefID a_loc) override;
+    void OnInstanceCountChanged(SourceSlot a_slot, std::ptrdiff_t a_delta) override;
+    void OnSourceReset(SourceSlot a_slot) override;
+    void OnLocationChanged(SourceSlot a_slot, RefID a_loc) override;
+    void RebuildStageIndex();
+
+    // copy, because the index can change while the caller works on the sources
+    [[nodiscard]] std::vector<SourceSlot> GetSourcesAt(RefID a_loc) const;
+
+    // locations with data, for the event thread to read without sourceMutex_. rebuilt from location_index_
+    // after a batch of changes and published whole
+    struct LookupSnapshot {
+        std::unordered_set<RefID> locations;
+    };
+    Snapshot<LookupSnapshot> lookup_;
+    std::atomic<bool> lookup_dirty_ = false;
+    // republish if location_index_ changed. PublishLookup_ is for callers that already hold sourceMutex_
+    void PublishLookup();
+    void PublishLookup_();
 
     std::unordered_map<std::string, bool> _other_settings;
 
     unsigned int _instance_limit = 200000;
+    size_t n_instances_ = 0;  // kept in sync by the sources
 
     std::map<RefID, RefStop> _ref_stops_;
+    std::set<std::pair<float, RefID>> ref_deadlines_;  // (stop_time, refid) for every entry in _ref_stops_
+    std::set<RefID> ref_stops_fresh_;  // new or changed effects, handled in the next tick even if not due
+    Clock::time_point last_full_sweep_{};
+    float last_tick_hours_ = -1.f;  // game time the last tick collected the due refs at
+    static constexpr unsigned int full_sweep_every = 10;  // in ticker intervals
+
+    // these keep ref_deadlines_ in sync with _ref_stops_, call with queueMutex_ locked
+    // SetRefStop returns true if the ref has to be handled before the currently earliest deadline
+    bool SetRefStop(const RefStop& a_refstop);
+    std::map<RefID, RefStop>::iterator EraseRefStop(std::map<RefID, RefStop>::iterator it);
+    void ClearRefStops();
     std::set<RefID> queue_delete_;
 
     std::set<FormID> do_not_register;
 
+    // earliest pending update per location as of its last full update. a plain Update(ref) before that time has
+    // nothing to do, as long as nothing touched the location since (TouchLocation drops the entry) and a world object
+    // is still where it was
+    struct NextDue {
+        float time = 0.f;
+        uint32_t modulator_generation = 0;  // ModulatorGrid generation, world objects depend on what is around them
+        RE::NiPoint3 pos;  // of a world object
+        FormID cell = 0;
+    };
+    static constexpr float moved_far_enough = 1.f;  // game units, below that a world object counts as not moved
+    std::mutex next_due_mutex_;
+    std::unordered_map<RefID, NextDue> next_due_;
+    // touches that came in while an update was reading, so that it does not cache what it read
+    TouchStamps touch_stamps_;
+    std::atomic<size_t> n_updates_skipped_ = 0;
+    std::atomic<size_t> n_updates_executed_ = 0;
+    // call with sourceMutex_ locked, right after a full update of a_ref
+    void RecordNextDue(RE::TESObjectREFR* a_ref, float a_curr_time);
+    [[nodiscard]] bool IsUpToDate(RE::TESObjectREFR* a_ref);
+
+    // a full update of a location on this thread, from before it reads anything to RecordNextDue. nested ones go
+    // with the token of the outermost
+    class PendingUpdate {
+    public:
+        explicit PendingUpdate(Manager& a_manager) : manager_(a_manager), outermost_(!token_) {
+            if (!outermost_) return;
+            std::lock_guard lock(manager_.next_due_mutex_);
+            token_ = manager_.touch_stamps_.Begin();
+        }
+        PendingUpdate(const PendingUpdate&) = delete;
+        PendingUpdate& operator=(const PendingUpdate&) = delete;
+        ~PendingUpdate() {
+            if (!outermost_) return;
+            std::lock_guard lock(manager_.next_due_mutex_);
+            manager_.touch_stamps_.End(*token_);
+            token_.reset();
+        }
+
+        // of the update running on this thread, nullopt if there is none
+        [[nodiscard]] static std::optional<uint64_t> Token() { return token_; }
+
+    private:
+        Manager& manager_;
+        bool outermost_;
+        static inline thread_local std::optional<uint64_t> token_;
+    };
+
     void WoUpdateLoop(const std::vector<RefID>& refs);
 
     static void PreDeleteRefStop(RefStop& a_ref_stop, RE::NiAVObject* a_obj);
 
     void UpdateLoop();
 
+    // earliest deadline in wall time, capped by the next full sweep
+    std::optional<Clock::time_point> GetNextTickTime() override;
+
     void QueueWOUpdate(const RefStop& a_refstop);
 
-    static void UpdateRefStop(Source& src, const StageInstance& wo_inst, RefStop& a_ref_stop, float stop_t);
+    // the bookkeeping part of Update without the UpdateRef calls. from/to are cleared in barter where only one side is ours.
+    // looks the item up under sourceMutex_ shared first, untracked items never take it unique
+    void MoveItem(RE::TESObjectREFR*& from, RE::TESObjectREFR*& to, const RE::TESForm* what, Count count);
 
-    [[nodiscard]] unsigned int GetNInstances();
+    // UpdateRef after a move. the check runs without sourceMutex_ unique, a location the move left as it was is not
+    // updated. returns whether it was
+    bool UpdateRefIfChanged(RE::TESObjectREFR* a_ref);
+
+    // a_what is a delayer or transformer of a source with data at a_loc. call with sourceMutex_ locked, shared will do
+    [[nodiscard]] bool ModulatesAt(FormID a_what, RefID a_loc) const;
+
+    static void UpdateRefStop(Source& src, const StageInstance& wo_inst, RefStop& a_ref_stop, float stop_t);
 
     [[nodiscard]] Source* MakeSource(FormID source_formid, const DefaultSettings* settings);
 
@@ -58,33 +156,47 @@ class Manager final : public Ticker, public SaveLoadData {
 
     static void ApplyStageInWorld(RE::TESObjectREFR* wo_ref, const Stage& stage, RE::TESBoundObject* source_bound = nullptr);
 
+    // the InventorySnapshot arguments are of inventory_owner/moveFrom and get invalidated when items are moved
     static inline void ApplyEvolutionInInventoryX(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item,
-                                                   FormID new_item);
+                                                   FormID new_item, InventorySnapshot& a_inventory);
 
     static inline void ApplyEvolutionInInventory_(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item,
-                                                  FormID new_item);
+                                                  FormID new_item, InventorySnapshot& a_inventory);
 
     void ApplyEvolutionInInventory(const std::string& _qformtype_, RE::TESObjectREFR* inventory_owner, Count update_count,
-                                   FormID old_item, FormID new_item);
+                                   FormID old_item, FormID new_item, InventorySnapshot* a_inventory = nullptr);
 
-    static inline void RemoveItem(RE::TESObjectREFR* moveFrom, FormID item_id, Count count);
+    static inline void RemoveItem(RE::TESObjectREFR* moveFrom, FormID item_id, Count count, InventorySnapshot* a_inventory = nullptr);
 
     static void AddItem(RE::TESObjectREFR* addTo, RE::TESObjectREFR* addFrom, FormID item_id, Count count);
     
     void Init();
 
-    std::set<float> GetUpdateTimes(const RE::TESObjectREFR* inventory_owner);
-    bool UpdateInventory(RE::TESObjectREFR* ref, float t);
-    void UpdateInventory(RE::TESObjectREFR* ref);
+    // earliest positive hitting time of the instances of src at loc, 0 if there is none
+    [[nodiscard]] static float GetEarliestUpdateTime(Source& src, RefID loc);
+    // all instances at ref updated to t, the updates applied to the inventory, then the time modulation.
+    // StepInventory on the InventoryCatchUp of ref
+    bool UpdateInventory(RE::TESObjectREFR* ref, float t, InventorySnapshot& a_inventory);
+    // the updates of src at ref in the inventory, decayed items registered as their own source
+    void ApplyStageUpdates(Source& src, RE::TESObjectREFR* ref, const std::vector<StageUpdate>& updates, float t,
+                           InventorySnapshot& a_inventory);
+    // the inventory of a container for CatchUp
+    struct InventoryCatchUp;
+    // the loaded containers of a sleep or wait for TimeJump
+    struct TimeJumpModel;
+    // a_inventory: snapshot of ref that was possibly built before sourceMutex_ was taken
+    void UpdateInventory(RE::TESObjectREFR* ref, InventorySnapshot* a_inventory = nullptr);
     void UpdateWO(RE::TESObjectREFR* ref);
-	void SyncWithInventory(RE::TESObjectREFR* ref);
-    void UpdateRef(RE::TESObjectREFR* loc);
+	void SyncWithInventory(RE::TESObjectREFR* ref, InventorySnapshot* a_inventory = nullptr);
+    void UpdateRef(RE::TESObjectREFR* loc, InventorySnapshot* a_inventory = nullptr);
 
 	RefStop* GetRefStop(RefID refid);
 
 public:
     Manager(const std::vector<Source>& data, const std::chrono::milliseconds interval)
-        : Ticker([this]() { UpdateLoop(); }, interval), sources(data) {
+        : Ticker([this]() { UpdateLoop(); }, interval) {
+        for (const auto& src : data) sources.emplace_back(src);
+        SetDeadlineMode(Settings::ticker_deadline_mode);
         Init();
     }
 
@@ -105,11 +217,14 @@ public:
 
 	void ClearWOUpdateQueue() {
 		std::unique_lock lock(queueMutex_);
-	    _ref_stops_.clear();
+	    ClearRefStops();
 	}
 
-    // use it only for world objects! checks if there is a stage instance for the given refid
-    [[nodiscard]] bool RefIsRegistered(RefID refid);
+    // use it only for world objects! checks if there is a stage instance for the given refid.
+    // reads the published snapshot, so it does not wait for writers
+    [[nodiscard]] bool RefIsRegistered(RefID refid) const;
+
+    [[nodiscard]] size_t GetNLookupPublished() const { return lookup_.GetNPublished(); }
 
     void Register(FormID some_formid, Count count, RefID location_refid,
                                            Duration register_time = 0);
@@ -118,8 +233,27 @@ public:
 
 	void HandleCraftingExit();
 
+    // Update(ref) alone returns right away if ref has no pending updates and did not change since its last update
     void Update(RE::TESObjectREFR* from, RE::TESObjectREFR* to=nullptr, const RE::TESForm* what=nullptr, Count count=0);
 
+    // contents of a_loc changed outside of our bookkeeping, e.g. an item was added that we do not track
+    void TouchLocation(RefID a_loc);
+
+    // (skipped, executed) UpdateRef calls of Update, plain ones and the ones after moves
+    [[nodiscard]] std::pair<size_t, size_t> GetUpdateCounters() const {
+        return {n_updates_skipped_.load(), n_updates_executed_.load()};
+    }
+
+    struct ItemMove {
+        RefID from = 0;
+        RefID to = 0;
+        FormID what = 0;
+        Count count = 0;
+    };
+
+    // the moves in order, then one UpdateRef per location they touched. returns the number of UpdateRef calls
+    size_t Update(const std::vector<ItemMove>& a_moves);
+
 	void SwapWithStage(RE::TESObjectREFR* wo_ref);
 
     void Reset();
@@ -140,7 +274,7 @@ public:
 
     std::vector<Source> GetSources() {
 		std::shared_lock lock(sourceMutex_);
-        return sources;
+        return {sources.begin(), sources.end()};
     }
 
     std::map<RefID, float> GetUpdateQueue() {
@@ -152,12 +286,45 @@ public:
         return _ref_stops_copy;
     }
 
+    struct TimeJumpStats {
+        float hours = 0.f;
+        size_t n_due = 0;  // locations with something to update
+        size_t n_updated = 0;  // of those, the ones that were loaded
+        size_t n_jumped = 0;  // of those, the containers advanced at once by TimeJump
+        float ms = 0.f;
+    };
+
+    // after sleeping or waiting: finds the locations with updates between the two times in one pass per source
+    // and updates the loaded ones together, the containers through TimeJump. the rest catch up when they get loaded,
+    // as usual
+    void HandleTimeJump(float t_before, float t_after);
+
+    [[nodiscard]] TimeJumpStats GetLastTimeJump() {
+        std::shared_lock lock(sourceMutex_);
+        return last_time_jump_;
+    }
+
 	void HandleDynamicWO(RE::TESObjectREFR* ref);
 
     void HandleWOBaseChange(RE::TESObjectREFR* ref);
 
+    [[nodiscard]] unsigned int GetNInstances() const { return static_cast<unsigned int>(n_instances_); }
+    [[nodiscard]] unsigned int GetInstanceLimit() const { return _instance_limit; }
+
+    // editorid -> number of tracked instances
+    std::map<std::string, size_t> GetNInstancesPerSource() {
+        std::map<std::string, size_t> result;
+		std::shared_lock lock(sourceMutex_);
+        for (const auto& src : sources) {
+            if (const auto n = src.GetNInstances()) result[src.editorid] += n;
+        }
+        return result;
+    }
+
 	bool IsTickerActive() const {
 	    return isRunning();
 	}
 
+private:
+    TimeJumpStats last_time_jump_;  // under sourceMutex_
 };
\ No newline at end of file
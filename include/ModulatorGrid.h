@@ -0,0 +1,75 @@
+#pragma once
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+
+// Loaded references of the time modulator and transformer forms, in a SpatialHashGrid.
+// A space (worldspace or interior) is scanned once on its first query, after that the attach/detach and
+// container change events keep it up to date.
+class ModulatorGrid {
+public:
+    static ModulatorGrid* GetSingleton() {
+        static ModulatorGrid singleton;
+        return &singleton;
+    }
+
+    // new base forms make the already scanned spaces stale
+    void Track(const std::vector<FormID>& a_bases);
+
+    void OnAttach(const RE::TESObjectREFR* a_ref);
+    void OnDetach(RefID a_refid);
+
+    // forget everything, e.g. on load
+    void Clear();
+
+    // tracked references of a_bases that can be close enough to a_origin, nearest first.
+    // a_range > 0: distance of the positions, otherwise Settings::proximity_range between the bounds.
+    // true if a_origin is part of the running batch, then the candidates already passed the exact test
+    bool GetCandidates(const RE::TESObjectREFR* a_origin, float a_range, const std::vector<FormID>& a_bases, std::vector<RefID>& out);
+
+    // finds the modulators close enough to each of a_objects in one sweep and prune pass with the exact test,
+    // GetCandidates answers from it for these objects until EndBatch
+    void BeginBatch(const std::vector<const RE::TESObjectREFR*>& a_objects, float a_range);
+    void EndBatch();
+
+    // keeps a batch running for the lifetime of the scope
+    class Batch {
+    public:
+        Batch(const std::vector<const RE::TESObjectREFR*>& a_objects, const float a_range) {
+            GetSingleton()->BeginBatch(a_objects, a_range);
+        }
+        ~Batch() { GetSingleton()->EndBatch(); }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+    };
+
+    [[nodiscard]] size_t GetNTracked();
+
+    // changes whenever a tracked reference is added or removed
+    [[nodiscard]] uint32_t GetGeneration() const { return generation_.load(); }
+
+    // the exact test behind GetCandidates
+    static bool IsClose(const RE::TESObjectREFR* a_origin, const RE::TESObjectREFR* a_modulator, float a_range);
+
+private:
+    ModulatorGrid() = default;
+
+    // worldspace for exteriors, the cell itself for interiors. 0 if there is no cell
+    static FormID GetSpace(const RE::TESObjectREFR* a_ref);
+    static float GetRadius(const RE::TESObjectREFR* a_ref);
+
+    // call with mutex_ locked
+    void Add(const RE::TESObjectREFR* a_ref);
+    void ScanCell(const RE::TESObjectCELL* a_cell);
+    void ScanSpace(const RE::TESObjectREFR* a_origin);
+
+    // positions are taken when a ref is attached or placed, it may have moved a bit since
+    static constexpr float position_slack = 64.f;
+
+    std::mutex mutex_;
+    SpatialHashGrid grid_;
+    std::unordered_set<FormID> tracked_;
+    std::unordered_set<FormID> scanned_spaces_;
+    std::atomic<uint32_t> generation_ = 0;
+    // object -> modulator refs that passed the exact test, nearest first
+    std::unordered_map<RefID, std::vector<RefID>> batch_;
+};
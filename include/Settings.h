@@ -31,6 +31,7 @@ namespace Settings {
                    {{"Modules", moduleskeyvals}, {"Other Settings", otherkeysvals}};
     inline int nMaxInstances = 200000;
     inline int nForgettingTime = 2160;  // in hours
+    inline float cell_scan_budget_ms = 2.f;  // per frame, <= 0 scans the whole cell at once
     inline bool disable_warnings = false;
     inline std::atomic world_objects_evolve = false;
 	inline std::atomic placed_objects_evolve = false;
@@ -103,6 +104,7 @@ namespace Settings {
 	};
 
     inline Ticker::Intervals ticker_speed = Ticker::kNormal;
+    inline bool ticker_deadline_mode = false;  // sleep until the next due world object instead of the fixed interval
 
 
     const std::vector<std::string> fakes_allowedQFORMS = {"FOOD", "MISC"};
@@ -0,0 +1,79 @@
+#pragma once
+
+// Append-only storage with stable addresses: elements live in fixed size chunks, so growing never moves them.
+// Elements are addressed by their index, which stays the same until clear().
+template <typename T, size_t ChunkSize = 32>
+class SlotMap {
+    using Chunk = std::array<std::optional<T>, ChunkSize>;
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    size_t size_ = 0;
+
+    template <bool IsConst>
+    class Iterator {
+        using Owner = std::conditional_t<IsConst, const SlotMap, SlotMap>;
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() = default;
+        Iterator(Owner* owner, const size_t index) : owner_(owner), index_(index) {}
+
+        reference operator*() const { return (*owner_)[index_]; }
+        pointer operator->() const { return &(*owner_)[index_]; }
+
+        Iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto temp = *this;
+            ++index_;
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    SlotMap() = default;
+    SlotMap(const SlotMap&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == chunks_.size() * ChunkSize) chunks_.push_back(std::make_unique<Chunk>());
+        auto& cell = (*chunks_[size_ / ChunkSize])[size_ % ChunkSize];
+        cell.emplace(std::forward<Args>(args)...);
+        ++size_;
+        return *cell;
+    }
+
+    T& operator[](const size_t i) { return *(*chunks_[i / ChunkSize])[i % ChunkSize]; }
+    const T& operator[](const size_t i) const { return *(*chunks_[i / ChunkSize])[i % ChunkSize]; }
+
+    T& back() { return (*this)[size_ - 1]; }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    // keeps the chunks around for reuse
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) (*chunks_[i / ChunkSize])[i % ChunkSize].reset();
+        size_ = 0;
+    }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, size_}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+// A value that readers load without a lock while a writer replaces it whole. A reader keeps the version it loaded
+// alive through the shared_ptr, a writer builds the next version on the side and publishes it in one store.
+// Writers have to be serialized by the caller.
+// The atomic shared_ptr takes a lock bit of its own on every load, a reader preempted holding it stalls the others.
+// So every thread keeps the last version it loaded and only goes to the atomic when the version count moved on. The
+// cached version stays alive until that thread loads again.
+template <typename T>
+class Snapshot {
+public:
+    Snapshot() : current_(std::make_shared<const T>()) {}
+
+    [[nodiscard]] std::shared_ptr<const T> Load() const {
+        thread_local Cache cache;
+        // published before the count moves on, so the pointer is at least as new as the count
+        if (const auto n = n_published_.load(std::memory_order_acquire); cache.id != id_ || cache.n_published != n) {
+            cache.value = current_.load();
+            cache.id = id_;
+            cache.n_published = n;
+        }
+        return cache.value;
+    }
+
+    void Publish(std::shared_ptr<const T> a_value) {
+        current_.store(std::move(a_value));
+        n_published_.fetch_add(1, std::memory_order_release);
+    }
+
+    [[nodiscard]] size_t GetNPublished() const { return n_published_.load(); }
+
+private:
+    struct Cache {
+        uint64_t id = 0;
+        size_t n_published = 0;
+        std::shared_ptr<const T> value;
+    };
+
+    // not the address, a new Snapshot can get the address of a gone one
+    static inline std::atomic<uint64_t> next_id_ = 1;
+
+    uint64_t id_ = next_id_++;
+    std::atomic<std::shared_ptr<const T>> current_;
+    std::atomic<size_t> n_published_ = 0;
+};
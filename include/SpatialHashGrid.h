@@ -0,0 +1,123 @@
+#pragma once
+
+// Uniform grid over the xy plane for points that belong to a base form and a space (worldspace or interior cell).
+// Buckets are keyed by (base, space, bx, by), so a lookup for a few bases only touches their buckets.
+// Knows nothing about the game, positions are plain floats.
+class SpatialHashGrid {
+public:
+    struct Entry {
+        RefID refid = 0;
+        FormID base = 0;
+        FormID space = 0;
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+        float radius = 0.f;  // rough extent of the object around its position
+    };
+
+    explicit SpatialHashGrid(const float a_bucket_size = 2048.f) : bucket_size_(a_bucket_size) {}
+
+    // replaces the entry with the same refid
+    void Insert(const Entry& a_entry) {
+        Erase(a_entry.refid);
+        entries_[a_entry.refid] = a_entry;
+        buckets_[KeyOf(a_entry.base, a_entry.space, a_entry.x, a_entry.y)].push_back(a_entry.refid);
+        max_radius_ = std::max(max_radius_, a_entry.radius);
+    }
+
+    bool Erase(const RefID a_refid) {
+        const auto it = entries_.find(a_refid);
+        if (it == entries_.end()) return false;
+        const auto& e = it->second;
+        if (const auto bucket = buckets_.find(KeyOf(e.base, e.space, e.x, e.y)); bucket != buckets_.end()) {
+            std::erase(bucket->second, a_refid);
+            if (bucket->second.empty()) buckets_.erase(bucket);
+        }
+        entries_.erase(it);
+        return true;
+    }
+
+    void Clear() {
+        entries_.clear();
+        buckets_.clear();
+        max_radius_ = 0.f;
+    }
+
+    // nullptr if there is no entry for a_refid
+    [[nodiscard]] const Entry* Find(const RefID a_refid) const {
+        const auto it = entries_.find(a_refid);
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] size_t GetNBuckets() const { return buckets_.size(); }
+    // upper bound of Entry::radius over everything inserted since the last Clear
+    [[nodiscard]] float GetMaxRadius() const { return max_radius_; }
+
+    template <typename F>
+    void ForEach(F&& func) const {
+        for (const auto& [refid, entry] : entries_) func(entry);
+    }
+
+    // entries of a_bases in a_space whose position is within a_range of (x, y, z), nearest first.
+    // a_bases without repeats, a base that is in it twice gives its entries twice
+    void Query(const FormID a_space, const float x, const float y, const float z, const float a_range,
+               const std::vector<FormID>& a_bases, std::vector<Entry>& out) const {
+        out.clear();
+        const auto bx0 = Cell(x - a_range);
+        const auto bx1 = Cell(x + a_range);
+        const auto by0 = Cell(y - a_range);
+        const auto by1 = Cell(y + a_range);
+        const float range2 = a_range * a_range;
+        for (const auto base : a_bases) {
+            for (auto bx = bx0; bx <= bx1; ++bx) {
+                for (auto by = by0; by <= by1; ++by) {
+                    const auto bucket = buckets_.find({base, a_space, bx, by});
+                    if (bucket == buckets_.end()) continue;
+                    for (const auto refid : bucket->second) {
+                        const auto& e = entries_.at(refid);
+                        if (Dist2(e, x, y, z) <= range2) out.push_back(e);
+                    }
+                }
+            }
+        }
+        std::ranges::sort(out, [x, y, z](const Entry& a, const Entry& b) { return Dist2(a, x, y, z) < Dist2(b, x, y, z); });
+    }
+
+private:
+    struct BucketKey {
+        FormID base;
+        FormID space;
+        int32_t bx;
+        int32_t by;
+
+        bool operator==(const BucketKey&) const = default;
+    };
+
+    struct BucketKeyHash {
+        size_t operator()(const BucketKey& k) const {
+            size_t h = std::hash<uint64_t>{}(static_cast<uint64_t>(k.base) << 32 | k.space);
+            h ^= std::hash<uint64_t>{}(static_cast<uint64_t>(static_cast<uint32_t>(k.bx)) << 32 | static_cast<uint32_t>(k.by)) +
+                 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    [[nodiscard]] int32_t Cell(const float v) const { return static_cast<int32_t>(std::floor(v / bucket_size_)); }
+
+    [[nodiscard]] BucketKey KeyOf(const FormID a_base, const FormID a_space, const float x, const float y) const {
+        return {a_base, a_space, Cell(x), Cell(y)};
+    }
+
+    static float Dist2(const Entry& e, const float x, const float y, const float z) {
+        const float dx = e.x - x;
+        const float dy = e.y - y;
+        const float dz = e.z - z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    float bucket_size_;
+    float max_radius_ = 0.f;
+    std::unordered_map<RefID, Entry> entries_;
+    std::unordered_map<BucketKey, std::vector<RefID>, BucketKeyHash> buckets_;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+// Stage arithmetic on the durations of a source, stage numbers 0..n-1.
+// Knows nothing about the game, like SpatialHashGrid.
+// Everything is summed in float in the same order as the loops in Source did before, so the results are the same
+// bit for bit. A stage the instance stays in is not affected by how the sum of the others is rounded.
+namespace StageMath {
+    using No = unsigned int;  // StageNo
+
+    struct Table {
+        std::vector<float> durations;
+        // remaining[k] = durations[k] + ... + durations[n-1], added up from k on
+        std::vector<float> remaining;
+
+        [[nodiscard]] No size() const { return static_cast<No>(durations.size()); }
+    };
+
+    // O(n^2), n is a handful of stages and this runs when the stages change
+    inline Table Build(std::vector<float> a_durations) {
+        Table table{std::move(a_durations), {}};
+        table.remaining.resize(table.durations.size());
+        for (No k = 0; k < table.size(); ++k) {
+            float total = 0;
+            for (auto j = k; j < table.size(); ++j) total += table.durations[j];
+            table.remaining[k] = total;
+        }
+        return table;
+    }
+
+    struct Position {
+        No no = 0;
+        float diff = 0.f;  // time spent in stage no
+    };
+
+    // where an instance that is a_diff (>= 0) into stage a_no ends up after passing every stage it has the time for.
+    // no == n once it is past the last stage
+    inline Position Forward(const Table& a_table, No a_no, float a_diff) {
+        while (a_no < a_table.size() && a_diff >= a_table.durations[a_no]) {
+            a_diff -= a_table.durations[a_no];
+            ++a_no;
+        }
+        return {a_no, a_diff};
+    }
+
+    // total duration from the start of stage a_no to the end of the last stage
+    inline float Remaining(const Table& a_table, const No a_no) {
+        return a_no < a_table.size() ? a_table.remaining[a_no] : 0.f;
+    }
+}
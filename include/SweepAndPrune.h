@@ -0,0 +1,72 @@
+#pragma once
+#include <bit>
+
+// Broad phase between two sets of axis aligned boxes: reports every (a, b) pair that shares a space and whose boxes overlap.
+// Sorts each set once on min x and scans forward from every box, so the cost is n log n plus the pairs that overlap in x.
+// Knows nothing about the game, like SpatialHashGrid.
+namespace SweepAndPrune {
+    struct Box {
+        FormID space = 0;
+        float min[3]{};
+        float max[3]{};
+    };
+
+    // cube of half extent a_half around (x, y, z)
+    inline Box Around(const FormID a_space, const float x, const float y, const float z, const float a_half) {
+        return {a_space, {x - a_half, y - a_half, z - a_half}, {x + a_half, y + a_half, z + a_half}};
+    }
+
+    // orders like (space, min x): the float bits are flipped so that they compare as unsigned integers
+    inline uint64_t SortKey(const Box& a_box) {
+        const auto bits = std::bit_cast<uint32_t>(a_box.min[0]);
+        const auto ordered = bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+        return static_cast<uint64_t>(a_box.space) << 32 | ordered;
+    }
+
+    // on_pair(index in a, index in b)
+    template <typename Callback>
+    void Pairs(const std::vector<Box>& a, const std::vector<Box>& b, Callback&& on_pair) {
+        // both sets sorted on (space, min x). the sort moves 16 byte keys, the boxes are gathered after it so that the
+        // scans below read them in order
+        const auto sorted = [](const std::vector<Box>& boxes) {
+            std::vector<std::pair<uint64_t, size_t>> keys;
+            keys.reserve(boxes.size());
+            for (size_t i = 0; i < boxes.size(); ++i) keys.emplace_back(SortKey(boxes[i]), i);
+            std::ranges::sort(keys, std::less{}, &std::pair<uint64_t, size_t>::first);
+            std::vector<std::pair<Box, size_t>> out;
+            out.reserve(boxes.size());
+            for (const auto i : keys | std::views::values) out.emplace_back(boxes[i], i);
+            return out;
+        };
+        const auto sorted_a = sorted(a);
+        const auto sorted_b = sorted(b);
+        const auto before = [](const Box& l, const Box& r) { return std::tie(l.space, l.min[0]) <= std::tie(r.space, r.min[0]); };
+        const auto overlap_yz = [](const Box& l, const Box& r) {
+            return (l.min[1] <= r.max[1]) & (r.min[1] <= l.max[1]) & (l.min[2] <= r.max[2]) & (r.min[2] <= l.max[2]);
+        };
+
+        // merge the two in that order. every box only scans forward in the other set, over the boxes that start
+        // inside its x interval. a pair that overlaps in x is found from whichever of the two starts first, so
+        // exactly once and without a list of open boxes to keep
+        size_t next_a = 0;
+        size_t next_b = 0;
+        while (next_a < sorted_a.size() && next_b < sorted_b.size()) {
+            if (const auto& [box, i] = sorted_a[next_a]; before(box, sorted_b[next_b].first)) {
+                for (auto k = next_b; k < sorted_b.size(); ++k) {
+                    const auto& [other, j] = sorted_b[k];
+                    if (other.space != box.space || other.min[0] > box.max[0]) break;
+                    if (overlap_yz(box, other)) on_pair(i, j);
+                }
+                ++next_a;
+            } else {
+                const auto& [box_b, j] = sorted_b[next_b];
+                for (auto k = next_a; k < sorted_a.size(); ++k) {
+                    const auto& [other, i_a] = sorted_a[k];
+                    if (other.space != box_b.space || other.min[0] > box_b.max[0]) break;
+                    if (overlap_yz(other, box_b)) on_pair(i_a, j);
+                }
+                ++next_b;
+            }
+        }
+    }
+};
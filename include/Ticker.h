@@ -1,28 +1,85 @@
 // https://github.com/ozooma10/OSLAroused-SKSE/blob/master/src/Utilities/Ticker.h
 #pragma once
 
+// One worker thread for the lifetime of the ticker. Pause() parks it on a condition variable, Resume() wakes it up again.
 class Ticker {
 public:
-    virtual ~Ticker() = default;
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t wakeups = 0;  // every time the worker came out of a wait
+        uint64_t ticks = 0;
+        std::chrono::microseconds last_tick{0};
+        std::chrono::microseconds max_tick{0};
+        std::chrono::microseconds total_tick{0};
+    };
+
+    // no join here: a static ticker is destroyed while the dll detaches, under the loader lock.
+    // by then the process is exiting and windows has already ended the worker, so it is only let go
+    virtual ~Ticker() {
+        RequestShutdown();
+        if (m_Thread.joinable()) m_Thread.detach();
+    }
 
     Ticker(const std::function<void()>& onTick, const std::chrono::milliseconds interval)
-        : m_OnTick(onTick), m_Interval(interval), m_ThreadActive(false), m_Running(false) {}
+        : m_OnTick(onTick), m_Interval(interval), m_Running(false) {}
+
+    Ticker(const Ticker&) = delete;
+    Ticker& operator=(const Ticker&) = delete;
+
+    // starts the worker on first use
+    void Resume();
 
-    void Start();
+    // the worker finishes the current tick and parks
+    void Pause();
 
-    void Stop() { m_Running = false; }
+    // ends the worker for good and waits for it, can be called from the worker itself
+    void Shutdown();
 
     void UpdateInterval(std::chrono::milliseconds newInterval);
 
+    // deadline mode: sleep until GetNextTickTime() instead of a fixed interval
+    void SetDeadlineMode(bool a_enabled);
+
+    // ends the current wait early, e.g. when something got queued that is due before it
+    void WakeUp();
+
 	bool isRunning() const { return m_Running; }
+    bool IsDeadlineMode() const { return m_DeadlineMode; }
+
+    [[nodiscard]] Stats GetStats();
+
+protected:
+    // when the next tick is needed in deadline mode. nullopt falls back to the interval
+    virtual std::optional<Clock::time_point> GetNextTickTime() { return std::nullopt; }
+
+    std::chrono::milliseconds GetInterval();
+
+    // first wait when GetNextTickTime() is already past after a tick. doubles while it stays past, up to the interval,
+    // so something that stays overdue (paused game, ref that can't be handled yet) doesn't keep the thread busy
+    static constexpr std::chrono::milliseconds min_backoff{10};
 
 private:
     void RunLoop();
 
+    // tells the worker to end without waiting for it
+    void RequestShutdown();
+
     std::function<void()> m_OnTick;
     std::chrono::milliseconds m_Interval;
 
-    std::atomic<bool> m_ThreadActive;
+    std::thread m_Thread;
     std::atomic<bool> m_Running;
+    std::atomic<bool> m_DeadlineMode = false;
+    std::chrono::milliseconds m_Backoff = min_backoff;  // worker only
     std::mutex m_IntervalMutex;
-};
\ No newline at end of file
+
+    // guards m_WakeRequested and m_Shutdown, and the changes of m_Running so no notify gets lost
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCV;
+    bool m_WakeRequested = false;
+    bool m_Shutdown = false;
+
+    std::mutex m_StatsMutex;
+    Stats m_Stats;
+};
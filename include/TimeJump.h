@@ -0,0 +1,149 @@
+#pragma once
+
+// Sleep and wait: the locations with updates between the two times are advanced to the end time at once, instead of
+// stepping through every update time in between like CatchUp does for one location at a time.
+//   - per source one batch of next update times over all of these locations (NextUpdateTimes), then only the
+//     instances that are due get updated, each straight to the end time
+//   - the updates of a location are applied together, the ones with the same source and stages netted into one
+//   - decay products are registered at the time they were made, the next round advances them to the end time
+//   - every source is cleaned up once at the end, so instances that stepping would have forgotten on the way are
+//     advanced first, and almost same ones get merged at the end time only
+// That is stepping up to rounding and merging only where nothing the jump changes can change the time modulation. Locations
+// where an item can evolve into or out of a time modulator, or where a transformer is present (it only takes some
+// stages), are caught up by the model instead. A source that only gets created by a decay product is not known
+// beforehand, its modulators are not looked at.
+// Knows nothing about the game. Model is the world being updated, see Manager::TimeJumpModel:
+//   Instance, Slot, Update              Update has oldstage, newstage (pointers), count and update_time
+//   Sources()                           the healthy sources
+//   SourcesAt(loc)                      sources with instances at loc
+//   Instances(slot, loc)                nullptr if the source has nothing at loc
+//   NextUpdateTimes(slot, locs, out)    of the instances at locs, in order, as one batch. 0 for none
+//   UpdateStage(slot, loc, inst, t, out)  UpdateAllStages for one instance, its update appended to out
+//   Apply(loc, netted, updates)         one location: the netted (slot, update) pairs in the inventory, the decay
+//                                       products among updates registered at their update_time. true if any was
+//   CleanUp(slot)                       CleanUpData
+//   CatchUp(loc)                        the stepping update of one location
+//   Produces(slot)                      forms its instances can turn into: stages, decayed and transformed forms
+//   Modulators(slot)                    its delayer and transformer forms
+//   SourceOf(formid)                    the source that has it as a stage, nullopt if there is none (yet)
+//   HasTransformer(slot, loc)           a transformer of the source is present at loc
+template <typename Model>
+class TimeJump {
+public:
+    using Instance = typename Model::Instance;
+    using Slot = typename Model::Slot;
+    using Update = typename Model::Update;
+
+    struct Stats {
+        size_t jumped = 0;      // locations advanced here
+        size_t caught_up = 0;   // locations left to CatchUp
+        size_t rows = 0;        // instances in the batches
+        size_t updated = 0;     // UpdateStage calls
+        size_t applied = 0;     // inventory changes after netting
+        size_t rounds = 0;
+    };
+
+    TimeJump(Model& a_model, const float a_t_after) : model_(a_model), t_after_(a_t_after) {}
+
+    void Run(const std::vector<RefID>& a_locs) {
+        std::vector<RefID> jumped;
+        std::vector<RefID> caught_up;
+        Classify(a_locs, jumped, caught_up);
+        stats_.jumped = jumped.size();
+        stats_.caught_up = caught_up.size();
+        for (const auto loc : caught_up) model_.CatchUp(loc);
+
+        std::set<Slot> touched;
+        std::vector<std::vector<std::pair<Slot, Update>>> updates;
+        std::vector<std::pair<Slot, Update>> netted;
+        std::vector<Update> scratch;
+        std::vector<float> times;
+        // a product can decay into the product of another source, every round goes one link further down that chain
+        const size_t max_rounds = model_.Sources().size() + 1;
+        for (auto pending = std::move(jumped); !pending.empty() && stats_.rounds < max_rounds;) {
+            ++stats_.rounds;
+            updates.assign(pending.size(), {});
+            for (const auto i : model_.Sources()) {
+                model_.NextUpdateTimes(i, pending, times);
+                size_t row = 0;
+                for (size_t k = 0; k < pending.size(); ++k) {
+                    auto* instances = model_.Instances(i, pending[k]);
+                    if (!instances) continue;
+                    for (auto& inst : *instances) {
+                        const auto t = times[row++];
+                        if (t <= 0.f || t > t_after_) continue;
+                        ++stats_.updated;
+                        scratch.clear();
+                        if (!model_.UpdateStage(i, pending[k], inst, t_after_, scratch)) continue;
+                        for (auto& update : scratch) updates[k].emplace_back(i, std::move(update));
+                        touched.insert(i);
+                    }
+                }
+                stats_.rows += row;
+            }
+
+            std::vector<RefID> next;
+            for (size_t k = 0; k < pending.size(); ++k) {
+                if (updates[k].empty()) continue;
+                // products get registered in the order stepping makes them
+                std::ranges::stable_sort(updates[k], std::less{}, [](const auto& u) { return u.second.update_time; });
+                Net(updates[k], netted);
+                stats_.applied += netted.size();
+                if (model_.Apply(pending[k], netted, updates[k])) next.push_back(pending[k]);
+            }
+            pending = std::move(next);
+        }
+        for (const auto i : touched) model_.CleanUp(i);
+    }
+
+    [[nodiscard]] const Stats& GetStats() const { return stats_; }
+
+    // one update per source and pair of stages with the counts summed, in the order they first come up in
+    static void Net(const std::vector<std::pair<Slot, Update>>& a_updates, std::vector<std::pair<Slot, Update>>& out) {
+        out.clear();
+        for (const auto& [slot, update] : a_updates) {
+            const auto same = [&](const std::pair<Slot, Update>& kept) {
+                return kept.first == slot && kept.second.oldstage == update.oldstage && kept.second.newstage == update.newstage;
+            };
+            if (const auto it = std::ranges::find_if(out, same); it != out.end()) it->second.count += update.count;
+            else out.emplace_back(slot, update);
+        }
+    }
+
+private:
+    // a location can be jumped if no source there, nor any source their products are stages of, can change the time
+    // modulation by evolving or has a transformer present
+    void Classify(const std::vector<RefID>& a_locs, std::vector<RefID>& jumped, std::vector<RefID>& caught_up) {
+        std::set<FormID> modulators;
+        for (const auto i : model_.Sources()) {
+            for (const auto formid : model_.Modulators(i)) modulators.insert(formid);
+        }
+        std::map<Slot, bool> moves_modulators;
+        std::map<Slot, std::vector<Slot>> decays_into;
+        for (const auto i : model_.Sources()) {
+            auto& moves = moves_modulators[i];
+            for (const auto formid : model_.Produces(i)) {
+                if (modulators.contains(formid)) moves = true;
+                if (const auto j = model_.SourceOf(formid); j && *j != i) decays_into[i].push_back(*j);
+            }
+        }
+
+        std::vector<Slot> reachable;
+        for (const auto loc : a_locs) {
+            reachable = model_.SourcesAt(loc);
+            for (size_t k = 0; k < reachable.size(); ++k) {
+                for (const auto j : decays_into[reachable[k]]) {
+                    if (std::find(reachable.begin(), reachable.end(), j) == reachable.end()) reachable.push_back(j);
+                }
+            }
+            const bool dynamic = std::ranges::any_of(reachable, [&](const Slot i) {
+                return moves_modulators[i] || model_.HasTransformer(i, loc);
+            });
+            (dynamic ? caught_up : jumped).push_back(loc);
+        }
+    }
+
+    Model& model_;
+    float t_after_;
+    Stats stats_;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+// Which locations were touched while an update that read them was pending. An update takes a token before it reads
+// anything (Begin) and gives it back when it is done (End). Touch stamps a location with a newer time, TouchedSince
+// tells the update that what it read might be behind. A stamp is only kept while an update older than it is pending,
+// so there are never more stamps than locations touched during the pending updates.
+// Not synchronized, the Manager calls it under next_due_mutex_.
+class TouchStamps {
+public:
+    [[nodiscard]] uint64_t Begin() {
+        pending_.insert(clock_);
+        return clock_;
+    }
+
+    void End(const uint64_t a_token) {
+        if (const auto it = pending_.find(a_token); it != pending_.end()) pending_.erase(it);
+        // stamps from before the oldest pending token, no pending update can be behind them
+        if (pending_.empty()) stamps_.clear();
+        else if (stamps_.size() > prune_above) {
+            const auto oldest = *pending_.begin();
+            std::erase_if(stamps_, [oldest](const auto& stamp) { return stamp.second <= oldest; });
+        }
+    }
+
+    void Touch(const RefID a_loc) {
+        if (!pending_.empty()) stamps_[a_loc] = ++clock_;
+    }
+
+    [[nodiscard]] bool TouchedSince(const RefID a_loc, const uint64_t a_token) const {
+        const auto it = stamps_.find(a_loc);
+        return it != stamps_.end() && it->second > a_token;
+    }
+
+    [[nodiscard]] size_t size() const { return stamps_.size(); }
+
+    // forgets the stamps, the pending tokens stay valid
+    void clear() { stamps_.clear(); }
+
+    static constexpr size_t prune_above = 64;
+
+private:
+    uint64_t clock_ = 0;
+    std::multiset<uint64_t> pending_;
+    std::unordered_map<RefID, uint64_t> stamps_;
+};
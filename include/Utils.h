@@ -109,6 +109,33 @@ void ForEachForm(std::function<bool(T*)> a_callback) {
 // https://github.com/SteveTownsend/SmartHarvestSE/blob/f709333c4cedba061ad21b4d92c90a720e20d2b1/src/WorldState/LocationTracker.cpp#L756
 bool AreAdjacentCells(RE::TESObjectCELL* cellA, RE::TESObjectCELL* cellB);
 
+// Session wide table of editor ids. Strings are never removed, so ids and resolved references stay valid.
+// 0 is the empty string.
+class EditorIDPool {
+public:
+    using ID = uint32_t;
+
+    static EditorIDPool* GetSingleton() {
+        static EditorIDPool singleton;
+        return &singleton;
+    }
+
+    ID Intern(std::string_view a_editorid);
+    ID Intern(const RE::TESForm* a_form);
+
+    // 0 if it was never interned
+    [[nodiscard]] ID Find(std::string_view a_editorid) const;
+
+    [[nodiscard]] const std::string& Resolve(ID a_id) const;
+
+private:
+    EditorIDPool() { strings_.emplace_back(); }
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> strings_;  // deque so that the views in ids_ stay valid
+    std::unordered_map<std::string_view, ID> ids_;
+};
+
 namespace Types {
 
     struct FormFormID {
@@ -136,7 +163,11 @@ namespace Types {
         bool operator<(const FormEditorID& other) const;
     };
 
-    struct FormEditorIDX : FormEditorID {
+    // same as FormEditorID but with the editor id interned
+    struct FormEditorIDX {
+        FormID form_id = 0;
+        EditorIDPool::ID editor_id = 0;
+
         bool is_fake = false;
         bool is_decayed = false;
         bool is_transforming = false;
@@ -144,6 +175,13 @@ namespace Types {
 
 
         bool operator==(const FormEditorIDX& other) const;
+
+        // all members, == only compares the form
+        [[nodiscard]] bool Identical(const FormEditorIDX& other) const {
+            return form_id == other.form_id && editor_id == other.editor_id && is_fake == other.is_fake &&
+                   is_decayed == other.is_decayed && is_transforming == other.is_transforming &&
+                   crafting_allowed == other.crafting_allowed;
+        }
 	};
 
 };
@@ -181,6 +219,7 @@ namespace Math {
             std::vector<RE::NiPoint3> positions;
             std::vector<uint16_t> indexes;
             const RE::TESObjectREFR* obj;
+            bool has_vertices = false;
 
 	        void FetchVertices(const RE::BSGeometry* o3d, RE::BSGraphics::TriShape* triShape);
 
@@ -191,6 +230,10 @@ namespace Math {
 	        ~Geometry() = default;
             explicit Geometry(const RE::TESObjectREFR* obj);
             [[nodiscard]] std::pair<RE::NiPoint3, RE::NiPoint3> GetBoundingBox() const;
+            // unscaled, in the frame of the reference
+            [[nodiscard]] std::pair<RE::NiPoint3, RE::NiPoint3> GetLocalBoundingBox() const;
+            // false if the bounds come from the object bounds because there was no loaded 3D
+            [[nodiscard]] bool HasVertices() const { return has_vertices; }
         };
 
         std::array<RE::NiPoint3,3> GetClosest3Vertices(const std::array<RE::NiPoint3, 8>& a_bounding_box, const RE::NiPoint3& outside_point);
@@ -388,6 +431,9 @@ namespace WorldObject {
 	void DrawBoundingBox(const std::array<RE::NiPoint3, 8>& a_box);
 	bool IsInBoundingBox(const std::array<RE::NiPoint3, 8>& a_box, const RE::NiPoint3& a_point);
     bool IsInTriangle(const RE::NiPoint3& A, const RE::NiPoint3& B, const RE::NiPoint3& C, const RE::NiPoint3& P);
+    // unscaled model bounds of a_obj in its own frame, cached per base form once the 3D is loaded
+    std::pair<RE::NiPoint3, RE::NiPoint3> GetLocalBounds(const RE::TESObjectREFR* a_obj);
+	// closest point of the oriented bounding box of a_obj_to
 	RE::NiPoint3 GetClosestPoint(const RE::NiPoint3& a_point_from , const RE::TESObjectREFR* a_obj_to);
 
     bool AreClose(const RE::TESObjectREFR* a_obj1, const RE::TESObjectREFR* a_obj2, float threshold);
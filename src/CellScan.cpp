@@ -0,0 +1,97 @@
+#include "CellScan.h"
+#include "Settings.h"
+
+void CellScan::Start(const std::vector<RE::TESObjectREFR*>& a_refs, Handler a_handler)
+{
+    const auto origin = WorldObject::GetPosition(RE::PlayerCharacter::GetSingleton());
+    std::vector<std::pair<float, RefID>> by_distance;
+    by_distance.reserve(a_refs.size());
+    for (const auto ref : a_refs) {
+        if (ref) by_distance.emplace_back(origin.GetDistance(ref->GetPosition()), ref->GetFormID());
+    }
+    std::ranges::sort(by_distance, std::greater{});
+
+    {
+        std::lock_guard lock(mutex_);
+        backlog_.clear();
+        backlog_.reserve(by_distance.size());
+        for (const auto refid : by_distance | std::views::values) backlog_.push_back(refid);
+        handler_ = std::move(a_handler);
+        stats_.backlog = backlog_.size();
+    }
+
+    if (Settings::cell_scan_budget_ms <= 0.f) return RunSlice();
+    Schedule();
+}
+
+void CellScan::Cancel()
+{
+    std::lock_guard lock(mutex_);
+    backlog_.clear();
+    stats_.backlog = 0;
+}
+
+CellScan::Stats CellScan::GetStats()
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+void CellScan::Schedule()
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (scheduled_ || backlog_.empty()) return;
+        scheduled_ = true;
+    }
+    SKSE::GetTaskInterface()->AddTask([this]() {
+        {
+            std::lock_guard lock(mutex_);
+            scheduled_ = false;
+        }
+        RunSlice();
+        Schedule();
+    });
+}
+
+void CellScan::RunSlice()
+{
+    const auto start = std::chrono::steady_clock::now();
+    const float budget = Settings::cell_scan_budget_ms;
+    const auto elapsed_ms = [&start]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    size_t n_done = 0;
+    std::vector<RefID> chunk;
+    std::vector<RE::TESObjectREFR*> refs;
+    Handler handler;
+    while (budget <= 0.f || elapsed_ms() < budget) {
+        {
+            std::lock_guard lock(mutex_);
+            if (backlog_.empty()) break;
+            const auto n = std::min(chunk_size, backlog_.size());
+            chunk.assign(backlog_.end() - static_cast<std::ptrdiff_t>(n), backlog_.end());
+            backlog_.resize(backlog_.size() - n);
+            handler = handler_;
+        }
+        refs.clear();
+        // nearest is at the back of the chunk
+        for (const auto refid : chunk | std::views::reverse) {
+            // it may have been picked up or unloaded since the scan started
+            const auto ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(refid);
+            if (!ref || ref->IsDisabled() || ref->IsDeleted() || !ref->GetParentCell()) continue;
+            refs.push_back(ref);
+        }
+        const ModulatorGrid::Batch batch({refs.begin(), refs.end()}, Settings::search_radius);
+        for (const auto ref : refs) handler(ref);
+        n_done += chunk.size();
+    }
+
+    std::lock_guard lock(mutex_);
+    stats_.backlog = backlog_.size();
+    stats_.last_slice_done = n_done;
+    stats_.last_slice_ms = elapsed_ms();
+    ++stats_.slices;
+    stats_.done += n_done;
+}
@@ -0,0 +1,83 @@
+#include "ContainerJournal.h"
+
+void ContainerJournal::Record(Manager* a_manager, const RefID a_from, const RefID a_to, const FormID a_what, const Count a_count)
+{
+    std::lock_guard lock(mutex_);
+    manager_ = a_manager;
+    ++stats_.events;
+
+    // only into the last move: one recorded in between can depend on it (A to B, B to C, A to B)
+    auto* last = pending_.empty() ? nullptr : &pending_.back();
+    if (last && last->what == a_what && last->from == a_from && last->to == a_to) {
+        last->count += a_count;
+    }
+    else if (last && last->what == a_what && last->from == a_to && last->to == a_from && a_count <= last->count) {
+        // moved back, net it out. more back than there was pending is a move of its own
+        last->count -= a_count;
+        if (last->count == 0) pending_.pop_back();
+    }
+    else {
+        pending_.push_back({a_from, a_to, a_what, a_count});
+    }
+    locs_.insert(a_from);
+    locs_.insert(a_to);
+
+    if (scheduled_) return;
+    scheduled_ = true;
+    SKSE::GetTaskInterface()->AddTask([this]() {
+        {
+            std::lock_guard lock(mutex_);
+            scheduled_ = false;
+        }
+        Flush();
+    });
+}
+
+void ContainerJournal::FlushIfTouches(const RefID a_loc, const RefID a_other)
+{
+    if (flushing_) return;
+    {
+        std::lock_guard lock(mutex_);
+        if (!(a_loc && locs_.contains(a_loc)) && !(a_other && locs_.contains(a_other))) return;
+        ++stats_.early;
+    }
+    Flush();
+}
+
+void ContainerJournal::Cancel()
+{
+    std::lock_guard lock(mutex_);
+    pending_.clear();
+    locs_.clear();
+}
+
+ContainerJournal::Stats ContainerJournal::GetStats()
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+void ContainerJournal::Flush()
+{
+    if (flushing_) return;
+    std::lock_guard flush_lock(flush_mutex_);
+    std::vector<Manager::ItemMove> moves;
+    Manager* manager;
+    {
+        std::lock_guard lock(mutex_);
+        moves.swap(pending_);
+        locs_.clear();
+        manager = manager_;
+    }
+    std::erase_if(moves, [](const Manager::ItemMove& move) { return move.count <= 0; });
+    if (moves.empty() || !manager) return;
+
+    flushing_ = true;
+    const auto n_updates = manager->Update(moves);
+    flushing_ = false;
+
+    std::lock_guard lock(mutex_);
+    stats_.moves += moves.size();
+    stats_.updates += n_updates;
+    ++stats_.flushes;
+}
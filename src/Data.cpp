@@ -1,6 +1,8 @@
 #include "Data.h"
+#include "ModulatorGrid.h"
 
 #include "DrawDebug.h"
+#include <numeric>
 
 void Source::Init(const DefaultSettings* defaultsettings) {
 
@@ -100,6 +102,22 @@ void Source::Init(const DefaultSettings* defaultsettings) {
         InitFailed();
 		return;
     }
+
+    BuildStageTable();
+}
+
+void Source::BuildStageTable()
+{
+    // CheckIntegrity made sure the stage numbers are 0..n-1
+    std::vector<Duration> durations;
+    for (StageNo no = 0; IsStageNo(no); ++no) {
+        // fake stages are registered only when they are first needed
+        Duration duration = 0;
+        if (const auto it = stages.find(no); it != stages.end()) duration = it->second.duration;
+        else if (const auto it2 = settings.durations.find(no); it2 != settings.durations.end()) duration = it2->second;
+        durations.push_back(duration);
+    }
+    stage_table = StageMath::Build(std::move(durations));
 }
 
 std::string_view Source::GetName() const {
@@ -116,6 +134,7 @@ void Source::UpdateAddons()
 	}
 	if (auto* addon = Settings::GetAddOnSettings(form); addon && addon->IsHealthy()) {
 		settings.Add(*addon);
+		InvalidateIntegrity();
 	}
 
     if (!settings.CheckIntegrity()) {
@@ -137,62 +156,72 @@ std::map<RefID, std::vector<StageUpdate>> Source::UpdateAllStages(const std::vec
 		return updated_instances;
 	}
 
+    std::vector<StageUpdate> updates;
     for (auto& reffid : filter) {
         if (!data.contains(reffid)) {
 			logger::warn("Refid {} not found in data.", reffid);
 			continue;
 		}
-        for (auto& instances = data.at(reffid); auto& instance : instances) {
-			const Stage* old_stage = IsStageNo(instance.no) ? &GetStage(instance.no) : nullptr;
-            if (UpdateStageInstance(instance, time)) {
-                Stage* new_stage = nullptr;
-                if (instance.xtra.is_transforming) {
-                    instance.xtra.is_decayed = true;
-                    instance.xtra.is_fake = false;
-                    const auto temp_formid = instance.GetDelayerFormID();
-                    if (!transformed_stages.contains(temp_formid)) {
-						logger::error("Transformed stage not found.");
-						continue;
-					}
-                    new_stage = &transformed_stages[temp_formid];
-					instance.xtra.is_transforming = false;
-                }
-                else if (instance.xtra.is_decayed || !IsStageNo(instance.no)) {
-                    new_stage = &decayed_stage;
-                }
-                auto is_fake_ = IsFakeStage(instance.no);
-                if (!new_stage) {
-                    updated_instances[reffid].emplace_back(old_stage, &GetStage(instance.no), instance.count,
-                                                            instance.start_time, is_fake_);
-                }
-                else {
-                    updated_instances[reffid].emplace_back(old_stage, new_stage, instance.count, instance.start_time ,
-                                                           is_fake_);
-                }
-            }
-        }
+        updates.clear();
+        for (auto& instance : data.at(reffid)) UpdateInstance(reffid, instance, time, updates);
+        if (!updates.empty()) updated_instances[reffid] = updates;
     }
     return updated_instances;
 }
 
-bool Source::IsStage(const FormID some_formid) {
-    return std::ranges::any_of(stages | std::views::values, [&](const auto& stage) {
-        return stage.formid == some_formid;
-    });
+bool Source::UpdateInstance(const RefID loc, StageInstance& instance, const float time, std::vector<StageUpdate>& out)
+{
+    return Evolution::Rules::UpdateInstance(*this, loc, instance, time, out);
+}
+
+bool Source::WouldChange(const StageInstance& instance, const float time)
+{
+    return Evolution::Rules::WouldChange(*this, instance, time);
+}
+
+void Source::Attach(SourceListener* a_listener, const SourceSlot a_slot)
+{
+    listener = a_listener;
+    slot = a_slot;
+    if (!listener) return;
+    for (const auto& stage_formid : stage_formids | std::views::keys) {
+        listener->OnStageRegistered(slot, stage_formid);
+    }
+    for (const auto& loc : data | std::views::keys) {
+        listener->OnLocationAdded(slot, loc);
+    }
+    if (n_instances) listener->OnInstanceCountChanged(slot, static_cast<std::ptrdiff_t>(n_instances));
 }
 
-inline bool Source::IsStageNo(const StageNo no) const {
-    return stages.contains(no) || fake_stages.contains(no);
+void Source::ChangeNInstances(const std::ptrdiff_t delta)
+{
+    if (!delta) return;
+    n_instances = static_cast<size_t>(static_cast<std::ptrdiff_t>(n_instances) + delta);
+    if (listener) listener->OnInstanceCountChanged(slot, delta);
 }
 
-inline bool Source::IsFakeStage(const StageNo no) const {
-	return fake_stages.contains(no);
+std::vector<StageInstance>& Source::GetOrAddLocation(const RefID loc)
+{
+    auto [it, inserted] = data.try_emplace(loc);
+    if (inserted && listener) listener->OnLocationAdded(slot, loc);
+    return it->second;
 }
 
-StageNo Source::GetStageNo(const FormID formid_) {
-    for (auto& [key, value] : stages) {
-        if (value.formid == formid_) return key;
-    }
+Source::SourceData::iterator Source::EraseLocation(const SourceData::iterator it)
+{
+    const auto loc = it->first;
+    const auto next = data.erase(it);
+    cleanup_schedule.Remove(loc);
+    if (listener) listener->OnLocationRemoved(slot, loc);
+    return next;
+}
+
+bool Source::IsStage(const FormID some_formid) const {
+    return stage_formids.contains(some_formid);
+}
+
+StageNo Source::GetStageNo(const FormID formid_) const {
+    if (const auto it = stage_formids.find(formid_); it != stage_formids.end()) return it->second;
     return 0;
 }
 
@@ -234,6 +263,14 @@ std::string Source::GetStageName(const StageNo no) const {
 	return "";
 }
 
+EditorIDPool::ID Source::GetStageEditorID(const Stage& stage)
+{
+    if (const auto it = stage_editorids.find(stage.formid); it != stage_editorids.end()) return it->second;
+    const auto id = EditorIDPool::GetSingleton()->Intern(stage.GetBound());
+    stage_editorids[stage.formid] = id;
+    return id;
+}
+
 StageInstance* Source::InsertNewInstance(const StageInstance& stage_instance, const RefID loc)
 {
     if (init_failed) {
@@ -271,20 +308,20 @@ StageInstance* Source::InsertNewInstance(const StageInstance& stage_instance, co
 		return nullptr;
 	}
 
-    if (!data.contains(loc)) {
-        data[loc] = {};
-    }
-    data[loc].push_back(stage_instance);
+    auto& instances = GetOrAddLocation(loc);
+    instances.push_back(stage_instance);
+    ChangeNInstances(1);
+    MarkDirty(loc);
 
     // fillout the xtra of the emplaced instance
     // get the emplaced instance
     /*auto& emplaced_instance = data.back();
     emplaced_instance.xtra.form_id = stages[n].formid;
-    emplaced_instance.xtra.editor_id = clib_util::editorID::get_editorID(stages[n].GetBound());
+    emplaced_instance.xtra.editor_id = GetStageEditorID(stages[n]);
     emplaced_instance.xtra.crafting_allowed = stages[n].crafting_allowed;
     if (IsFakeStage(n)) emplaced_instance.xtra.is_fake = true;*/
 
-	return &data[loc].back();
+	return &instances.back();
 }
 
 StageInstance* Source::InitInsertInstanceWO(StageNo n, const Count c, const RefID l, const Duration t_0)
@@ -299,7 +336,7 @@ StageInstance* Source::InitInsertInstanceWO(StageNo n, const Count c, const RefI
 	}
     StageInstance new_instance(t_0, n, c);
     new_instance.xtra.form_id = GetStage(n).formid;
-    new_instance.xtra.editor_id = clib_util::editorID::get_editorID(GetStage(n).GetBound());
+    new_instance.xtra.editor_id = GetStageEditorID(GetStage(n));
     new_instance.xtra.crafting_allowed = GetStage(n).crafting_allowed;
     if (IsFakeStage(n)) new_instance.xtra.is_fake = true;
 
@@ -345,9 +382,14 @@ bool Source::MoveInstance(const RefID from_ref, const RefID to_ref, const StageI
 
     // Remove the instance from the from_instances vector
     from_instances.erase(it);
+    MarkDirty(from_ref);
 
     // Add the instance to the to_ref key vector
-    if (to_ref > 0) data[to_ref].push_back(new_instance);
+    if (to_ref > 0) {
+        GetOrAddLocation(to_ref).push_back(new_instance);
+        MarkDirty(to_ref);
+    }
+    else ChangeNInstances(-1);
 
     return true;
 }
@@ -381,74 +423,31 @@ Count Source::MoveInstances(const RefID from_ref, const RefID to_ref, const Form
         return count;
 	}
 
-    std::vector<size_t> instances_candidates = {};
-    size_t index_ = 0;
-    for (const auto& st_inst : data.at(from_ref)) {
-        if (st_inst.xtra.form_id == instance_formid) {
-            instances_candidates.push_back(index_);
-        }
-        index_++;
-    }
-
-    if (instances_candidates.empty()) {
+    const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
+    const auto taken = InstanceOps::Take(data.at(from_ref), instance_formid, count, older_first, curr_time,
+                                         [this, to_ref](const size_t n_whole) -> std::vector<StageInstance>* {
+                                             if (to_ref > 0) {
+                                                 MarkDirty(to_ref);
+                                                 return &GetOrAddLocation(to_ref);
+                                             }
+                                             ChangeNInstances(-static_cast<std::ptrdiff_t>(n_whole));
+                                             return nullptr;
+                                         });
+    if (!taken.found) {
         logger::warn("No instances found for formid {} and location {}", instance_formid, from_ref);
         return 0;
     }
+    count = taken.count;
+    MarkDirty(from_ref);
 
-    const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
-    if (older_first) {
-        std::ranges::sort(instances_candidates,
-                          [this, from_ref, curr_time](const size_t a, const size_t b) {
-                              return this->data[from_ref][a].GetElapsed(curr_time) >
-                                     this->data[from_ref][b].GetElapsed(curr_time);  // move the older stuff
-                          });
-    } 
-    else {
-        std::ranges::sort(instances_candidates,
-                          [this, from_ref, curr_time](const size_t a, const size_t b) {
-                              return this->data[from_ref][a].GetElapsed(curr_time) <
-                                     this->data[from_ref][b].GetElapsed(curr_time);  // move the newer stuff
-                          });
-	}
-
-    std::vector<size_t> removed_indices;
-    for (size_t index: instances_candidates) {
-        if (!count) break;
-            
-        StageInstance* instance;
-        if (removed_indices.empty()) {
-            instance = &data[from_ref][index];
-        } else {
-            int shift = 0;
-            for (const size_t removed_index : removed_indices) {
-                if (index == removed_index) {
-                    logger::critical("Index is equal to removed index.");
-                    return count;
-                }
-                if (index > removed_index) shift++;
-            }
-            instance = &data[from_ref][index - shift];
-        }
-
-        if (count <= instance->count) {
-            instance->count -= count;
-            StageInstance new_instance(*instance);
-            new_instance.count = count;
-            if (to_ref > 0 && !InsertNewInstance(new_instance, to_ref)) {
-                logger::error("InsertNewInstance failed.");
-                return 0;
-            }
-            count = 0;
-        } 
-        else {
-            const auto count_temp = count;
-            count -= instance->count;
-            if (!MoveInstance(from_ref, to_ref, instance)) {
-				logger::error("MoveInstance failed.");
-                return count_temp;
-			}
-            removed_indices.push_back(index);
+    if (taken.split) {
+        StageInstance new_instance(*taken.split);
+        new_instance.count = count;
+        if (to_ref > 0 && !InsertNewInstance(new_instance, to_ref)) {
+            logger::error("InsertNewInstance failed.");
+            return 0;
         }
+        count = 0;
     }
     return count;
 }
@@ -472,9 +471,9 @@ bool Source::IsDecayedItem(const FormID _form_id) const {
                                });
 }
 
-inline FormID Source::GetModulatorInInventory(RE::TESObjectREFR* inventory_owner) const {
-    const auto inventory_owner_base_id = inventory_owner->GetBaseObject()->GetFormID();
-    const auto inventory = inventory_owner->GetInventory();
+inline FormID Source::GetModulatorInInventory(InventorySnapshot& a_inventory) const {
+    const auto inventory_owner_base_id = a_inventory.GetOwner()->GetBaseObject()->GetFormID();
+    const auto& inventory = a_inventory.Get();
     for (const auto& dlyr_fid : settings.delayers_order) {
         if (const auto entry = inventory.find(RE::TESForm::LookupByID<RE::TESBoundObject>(dlyr_fid));
             entry != inventory.end() && entry->second.first > 0) {
@@ -497,9 +496,9 @@ inline FormID Source::GetModulatorInWorld(const RE::TESObjectREFR* wo) const
     return SearchNearbyModulators(wo,candidates);
 }
 
-inline FormID Source::GetTransformerInInventory(RE::TESObjectREFR* inventory_owner) const {
-	const auto inventory_owner_base_id = inventory_owner->GetBaseObject()->GetFormID();
-    const auto inventory = inventory_owner->GetInventory();
+inline FormID Source::GetTransformerInInventory(InventorySnapshot& a_inventory) const {
+	const auto inventory_owner_base_id = a_inventory.GetOwner()->GetBaseObject()->GetFormID();
+    const auto& inventory = a_inventory.Get();
 	for (const auto& trns_fid : settings.transformers_order) {
 		if (const auto entry = inventory.find(RE::TESForm::LookupByID<RE::TESBoundObject>(trns_fid));
 			entry != inventory.end() && entry->second.first > 0) {
@@ -521,39 +520,11 @@ inline FormID Source::GetTransformerInWorld(const RE::TESObjectREFR* wo) const
     return SearchNearbyModulators(wo,candidates);
 }
 
-void Source::UpdateTimeModulationInInventory(RE::TESObjectREFR* inventory_owner, const float _time)
-{
-    if (!inventory_owner) {
-        logger::error("Inventory owner is null.");
-        return;
-    }
-
-    const RefID inventory_owner_refid = inventory_owner->GetFormID();
-    if (!inventory_owner_refid) {
-        logger::error("Inventory owner refid is 0.");
-        return;
-    }
-
-    if (!inventory_owner->HasContainer()) {
-        logger::error("Inventory owner does not have a container.");
-        return;
-    }
-
-    if (!data.contains(inventory_owner_refid)) {
-		//logger::error("Inventory owner refid not found in data: {} and source {}.", inventory_owner_refid, editorid);
-		return;
-	}
-
-    if (data.at(inventory_owner_refid).empty()) {
-        return;
-    }
-
-    SetDelayOfInstances(_time, inventory_owner);
-}
-
-void Source::UpdateTimeModulationInWorld(RE::TESObjectREFR* wo, StageInstance& wo_inst, const float _time) const
+void Source::UpdateTimeModulationInWorld(RE::TESObjectREFR* wo, StageInstance& wo_inst, const float _time)
 {
     SetDelayOfInstance(wo_inst, _time, wo, false);
+    // the decay time moves with the delay
+    MarkDirty(wo->GetFormID());
 }
 
 float Source::GetNextUpdateTime(StageInstance* st_inst) {
@@ -566,82 +537,107 @@ float Source::GetNextUpdateTime(StageInstance* st_inst) {
         logger::critical("GetNextUpdateTime: Source formid: {}, qformtype: {}", formid, qFormType);
         return 0;
     }
-    if (st_inst->xtra.is_decayed) return 0;
-    if (!IsStageNo(st_inst->no)) {
-        logger::error("Stage {} does not exist.", st_inst->no);
-        return 0;
+    return Evolution::Rules::GetNextUpdateTime(*this, *st_inst);
+}
+
+void Source::GetNextUpdateTimes(const RefID loc, std::vector<float>& out)
+{
+    out.clear();
+    if (!IsHealthy()) {
+        logger::critical("GetNextUpdateTimes: Source is not healthy.");
+        return;
     }
+    const auto it = data.find(loc);
+    if (it == data.end()) return;
+    const auto& instances = it->second;
 
-    const auto delay_slope = st_inst->GetDelaySlope();
-    if (std::abs(delay_slope) < EPSILON) {
-		//logger::warn("Delay slope is 0.");
-		return 0;
+    static thread_local Evolution::HittingInputs inputs;
+    inputs.clear();
+    Evolution::Rules::GatherHittingInputs(*this, instances, inputs);
+
+    inputs.Evaluate(out);
+}
+
+void Source::GetNextUpdateTimes(const std::vector<RefID>& locs, std::vector<float>& out)
+{
+    out.clear();
+    if (!IsHealthy()) {
+        logger::critical("GetNextUpdateTimes: Source is not healthy.");
+        return;
     }
 
-    if (st_inst->xtra.is_transforming) {
-        const auto transformer_form_id = st_inst->GetDelayerFormID();
-        if (!settings.transformers.contains(transformer_form_id)) return 0.0f;
-        const auto trnsfrm_duration = std::get<1>(settings.transformers.at(transformer_form_id));
-		return st_inst->GetTransformHittingTime(trnsfrm_duration);
+    Evolution::Rules::GetNextUpdateTimes(*this, locs, out);
+}
+
+void Source::GetLocationsDueBy(const float a_time, std::vector<RefID>& out)
+{
+    out.clear();
+    if (!IsHealthy()) {
+        logger::critical("GetLocationsDueBy: Source is not healthy.");
+        return;
     }
 
-    const auto schranke = delay_slope > 0 ? GetStage(st_inst->no).duration : 0.f;
+    // all locations in one batch, row_locs maps the rows back
+    static thread_local Evolution::HittingInputs inputs;
+    static thread_local std::vector<RefID> row_locs;
+    static thread_local std::vector<float> times;
+    static thread_local std::vector<uint8_t> due;
+    inputs.clear();
+    row_locs.clear();
+    for (const auto& [loc, instances] : data) {
+        Evolution::Rules::GatherHittingInputs(*this, instances, inputs);
+        row_locs.insert(row_locs.end(), instances.size(), loc);
+    }
 
-    return st_inst->GetHittingTime(schranke);
+    inputs.Evaluate(times);
+    due.resize(times.size());
+    HittingTimes::FlagDue(times.data(), a_time, due.data(), times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        // times <= 0 are not update times, GetEarliestUpdateTime skips them too
+        if (!due[i] || !inputs.has_next[i] || times[i] <= 0) continue;
+        // rows of a location are contiguous
+        if (out.empty() || out.back() != row_locs[i]) out.push_back(row_locs[i]);
+    }
 }
 
-void Source::CleanUpData()
+bool Source::CheckIntegrityCached()
 {
-    if (!CheckIntegrity()) {
+    if (integrity_checked_version != integrity_version) {
+        integrity_ok = CheckIntegrity();
+        integrity_checked_version = integrity_version;
+    }
+    return integrity_ok;
+}
+
+bool Source::CleanUpData(const RefID a_deferred)
+{
+    if (!CheckIntegrityCached()) {
 		logger::critical("CheckIntegrity failed");
 		InitFailed();
     }
 
     if (init_failed) {
         logger::critical("CleanUpData: Initialisation failed.");
-        return;
+        return false;
     }
     if (data.empty()) {
         logger::info("No data found for source {}", editorid);
-        return;
+        return false;
     }
-	
+
     const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
-    for (auto& instances : data | std::views::values) {
-        if (instances.empty()) continue;
-        if (instances.size() > 1) {
-            for (auto it = instances.begin(); it+1 != instances.end(); ++it) {
-                size_t ind = 1;
-                for (auto it2 = it + ind; it2 != instances.end(); it2 = it + ind) {
-					++ind;
-				    if (it == it2) continue;
-                    if (it2->count <= 0) continue;
-                    if (it->AlmostSameExceptCount(*it2, curr_time)) {
-					    it->count += it2->count;
-					    it2->count = 0;
-				    }
-			    }
-		    }
-        }
-        for (auto it = instances.begin(); it != instances.end();) {
-            const bool should_erase = 
-                (it->count <= 0) ||
-                (it->start_time > curr_time) ||
-                (it->xtra.is_decayed || !IsStageNo(it->no));
-
-            auto decay_time =  GetDecayTime(*it);
-            if (should_erase || 
-                decay_time > 0.f && curr_time-decay_time > static_cast<float>(Settings::nForgettingTime)) {
-                it = instances.erase(it);
-            }
-            else ++it;
-		}
-    }
-        
-    for (auto it = data.begin(); it != data.end();) {
-        if (it->second.empty()) it = data.erase(it);
-        else ++it;
-    }
+    return Evolution::Rules::CleanUpData(*this, curr_time, static_cast<float>(Settings::nForgettingTime), a_deferred);
+}
+
+bool Source::ShouldErase(const StageInstance& instance, const float curr_time)
+{
+    return Evolution::Rules::ShouldErase(*this, instance, curr_time, static_cast<float>(Settings::nForgettingTime));
+}
+
+void Source::FinishCleanUp(const RefID loc, const std::ptrdiff_t n_erased)
+{
+    const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
+    Evolution::Rules::FinishCleanUp(*this, loc, n_erased, curr_time, static_cast<float>(Settings::nForgettingTime));
 }
 
 void Source::PrintData()
@@ -677,89 +673,34 @@ void Source::Reset()
     formid = 0;
 	editorid = "";
 	stages.clear();
+    stage_formids.clear();
+    stage_editorids.clear();
+    stage_table = {};
 	data.clear();
+    ChangeNInstances(-static_cast<std::ptrdiff_t>(n_instances));
+    dirty_locs.clear();
+    cleanup_schedule.clear();
+    last_cleanup = -1.f;
+    InvalidateIntegrity();
 	init_failed = false;
+    if (listener) listener->OnSourceReset(slot);
 }
 
-bool Source::UpdateStageInstance(StageInstance& st_inst, const float curr_time) {
-    if (st_inst.xtra.is_decayed) return false;  // decayed
-    if (st_inst.xtra.is_transforming) {
-        if (const auto transformer_form_id = st_inst.GetDelayerFormID(); !settings.transformers.contains(transformer_form_id)) {
-			logger::error("Transformer Formid {} not found in default settings.", transformer_form_id);
-            st_inst.RemoveTransform(curr_time);
-		}
-        else {
-            const auto& transform_properties = settings.transformers[transformer_form_id];
-            const auto trnsfrm_duration = std::get<1>(transform_properties);
-            if (const auto trnsfrm_elapsed = st_inst.GetTransformElapsed(curr_time); trnsfrm_elapsed >= trnsfrm_duration) {
-                const auto& transformed_stage = transformed_stages[transformer_form_id];
-                st_inst.xtra.form_id = transformed_stage.formid;
-                st_inst.SetNewStart(curr_time, trnsfrm_elapsed - trnsfrm_duration);
-                return true;
-            }
-            return false;
-        }
+void Source::SetStageXtra(Types::FormEditorIDX& xtra, const StageNo no)
+{
+    const auto& stage = GetStage(no);
+    xtra.form_id = stage.formid;
+    xtra.editor_id = GetStageEditorID(stage);
+    xtra.is_fake = IsFakeStage(no);
+    xtra.crafting_allowed = stage.crafting_allowed;
+}
 
-    } 
-    else if (GetNStages() < 2 && GetFinalStage().formid == st_inst.xtra.form_id) {
-        st_inst.SetNewStart(curr_time, 0);
-		return false;
-	}
-    if (!IsStageNo(st_inst.no)) {
-		return false;
-	}
-    if (st_inst.count <= 0) {
-        return false;
-    }
-    float diff = st_inst.GetElapsed(curr_time);
-    bool updated = false;
-        
-    while (diff < 0) {
-        if (st_inst.no > 0) {
-            if (!IsStageNo(st_inst.no - 1)) {
-                logger::critical("Stage {} does not exist.", st_inst.no - 1);
-                return false;
-			}
-            st_inst.no--;
-            diff += GetStage(st_inst.no).duration;
-            updated = true;
-        } else {
-            diff = 0;
-            break;
-        }
-    }
-    while (diff >= GetStage(st_inst.no).duration) {
-        diff -= GetStage(st_inst.no).duration;
-		st_inst.no++;
-        updated = true;
-        if (!IsStageNo(st_inst.no)) {
-            st_inst.xtra.is_decayed= true;
-            st_inst.xtra.form_id = decayed_stage.formid;
-            st_inst.xtra.editor_id = clib_util::editorID::get_editorID(decayed_stage.GetBound());
-            st_inst.xtra.is_fake = false;
-            st_inst.xtra.crafting_allowed = false;
-            break;
-		}
-	}
-    if (updated) {
-        if (st_inst.xtra.is_decayed) {
-            st_inst.xtra.form_id = decayed_stage.formid;
-            st_inst.xtra.editor_id = clib_util::editorID::get_editorID(decayed_stage.GetBound());
-            st_inst.xtra.is_fake = false;
-            st_inst.xtra.crafting_allowed = false;
-        } 
-        else {
-            st_inst.xtra.form_id = GetStage(st_inst.no).formid;
-            st_inst.xtra.editor_id = clib_util::editorID::get_editorID(GetStage(st_inst.no).GetBound());
-            st_inst.xtra.is_fake = IsFakeStage(st_inst.no);
-            st_inst.xtra.crafting_allowed = GetStage(st_inst.no).crafting_allowed;
-        }
-        // as long as the delay start was before the ueberschreitung time this will work,
-        // the delay start cant be strictly after the ueberschreitung time bcs we call update when a new delay
-        // starts so the delay start will always be before the ueberschreitung time
-        st_inst.SetNewStart(curr_time,diff);
-    }
-    return updated;
+void Source::SetDecayedXtra(Types::FormEditorIDX& xtra)
+{
+    xtra.form_id = decayed_stage.formid;
+    xtra.editor_id = GetStageEditorID(decayed_stage);
+    xtra.is_fake = false;
+    xtra.crafting_allowed = false;
 }
 
 size_t Source::GetNStages() const {
@@ -792,33 +733,21 @@ Stage Source::GetTransformedStage(const FormID key_formid) const {
     return trnsf_st;
 }
 
-void Source::SetDelayOfInstances(const float some_time, RE::TESObjectREFR* inventory_owner)
+ModulationInputs Source::GetModulationInputs(const RE::TESObjectREFR* inventory_owner, InventorySnapshot& a_inventory) const
 {
-    const RefID loc = inventory_owner->GetFormID();
-    if (!data.contains(loc)) {
-        logger::error("Location {} does not exist.", loc);
-        return;
+    if (ShouldFreezeEvolution(inventory_owner->GetBaseObject()->GetFormID())) return {.freeze = true};
+    ModulationInputs inputs;
+    inputs.transformer = GetTransformerInInventory(a_inventory);
+    inputs.delayer = GetModulatorInInventory(a_inventory);
+    if (const auto it = settings.transformers.find(inputs.transformer); inputs.transformer && it != settings.transformers.end()) {
+        inputs.allowed_stages = &std::get<2>(it->second);
     }
-    if (ShouldFreezeEvolution(inventory_owner->GetBaseObject()->GetFormID())) {
-		for (auto& instance : data.at(loc)) {
-	        if (instance.count <= 0) continue;
-			instance.RemoveTimeMod(some_time);
-			instance.SetDelay(some_time, 0, 0); // freeze
-        }
-        return;
-    }
-
-    const auto transformer_best = GetTransformerInInventory(inventory_owner);
-    const auto delayer_best = GetModulatorInInventory(inventory_owner);
-    std::vector<StageNo> allowed_stages;
-	if (transformer_best && settings.transformers.contains(transformer_best)) {
-        allowed_stages = std::get<2>(settings.transformers[transformer_best]);
-	}
+    return inputs;
+}
 
-    for (auto& instance : data.at(loc)) {
-		if (instance.count <= 0) continue;
-		SetDelayOfInstance(instance, some_time, transformer_best, delayer_best, allowed_stages);
-	}
+bool Source::SetDelayOfInstance(StageInstance& instance, const float a_time, const ModulationInputs& a_inputs) const
+{
+    return Evolution::Rules::SetDelayOfInstance(*this, instance, a_time, a_inputs);
 }
 
 void Source::SetDelayOfInstance(StageInstance& instance, const float curr_time, RE::TESObjectREFR* a_object, const bool inventory_owner) const {
@@ -828,8 +757,9 @@ void Source::SetDelayOfInstance(StageInstance& instance, const float curr_time,
 		instance.SetDelay(curr_time, 0, 0); // freeze
         return;
     }
-	const auto transformer_best = inventory_owner ? GetTransformerInInventory(a_object) : GetTransformerInWorld(a_object);
-	const auto delayer_best = inventory_owner ? GetModulatorInInventory(a_object) : GetModulatorInWorld(a_object);
+    InventorySnapshot inventory(a_object);
+	const auto transformer_best = inventory_owner ? GetTransformerInInventory(inventory) : GetTransformerInWorld(a_object);
+	const auto delayer_best = inventory_owner ? GetModulatorInInventory(inventory) : GetModulatorInWorld(a_object);
     std::vector<StageNo> allowed_stages;
 	if (transformer_best && settings.transformers.contains(transformer_best)) {
         allowed_stages = std::get<2>(settings.transformers.at(transformer_best));
@@ -837,14 +767,10 @@ void Source::SetDelayOfInstance(StageInstance& instance, const float curr_time,
 	SetDelayOfInstance(instance, curr_time, transformer_best, delayer_best, allowed_stages);
 }
 
-void Source::SetDelayOfInstance(StageInstance& instance, const float a_time, const FormID a_transformer, const FormID a_delayer, const std::vector<
+bool Source::SetDelayOfInstance(StageInstance& instance, const float a_time, const FormID a_transformer, const FormID a_delayer, const std::vector<
                                 StageNo>& allowed_stages) const
 {
-	if (!a_transformer || !Vector::HasElement<StageNo>(allowed_stages, instance.no)) instance.RemoveTransform(a_time);
-	else return instance.SetTransform(a_time, a_transformer);
-
-	const float delay_ = !a_delayer ? 1 : settings.delayers.contains(a_delayer) ? settings.delayers.at(a_delayer) : 1;
-    instance.SetDelay(a_time, delay_, a_delayer);
+    return Evolution::Rules::SetDelayOfInstance(*this, instance, a_time, a_transformer, a_delayer, allowed_stages);
 }
 
 bool Source::CheckIntegrity() {
@@ -926,22 +852,6 @@ bool Source::CheckIntegrity() {
     return true;
 }
 
-float Source::GetDecayTime(const StageInstance& st_inst) {
-    if (const auto slope = st_inst.GetDelaySlope(); slope <= 0) return -1;
-    StageNo curr_stageno = st_inst.no;
-    if (!IsStageNo(curr_stageno)) {
-        logger::error("Stage {} does not exist.", curr_stageno);
-        return true;
-    }
-    const auto last_stage_no = GetLastStageNo();
-    float total_duration = 0;
-    while (curr_stageno <= last_stage_no) {
-        total_duration += GetStage(curr_stageno).duration;
-        curr_stageno+=1;
-	}
-    return st_inst.GetHittingTime(total_duration);
-}
-
 inline void Source::InitFailed()
 {
     logger::error("Initialisation failed for formid {}.",formid);
@@ -951,11 +861,9 @@ inline void Source::InitFailed()
 
 void Source::RegisterStage(const FormID stage_formid, const StageNo stage_no)
 {
-    for (const auto& value : stages | std::views::values) {
-        if (stage_formid == value.formid) {
-            logger::error("stage_formid is already in the stages.");
-            return;
-        }
+    if (stage_formids.contains(stage_formid)) {
+        logger::error("stage_formid is already in the stages.");
+        return;
     }
     if (stage_formid == formid && stage_no != 0) {
         // not allowed. if you want to go back to beginning use decayed stage
@@ -983,6 +891,9 @@ void Source::RegisterStage(const FormID stage_formid, const StageNo stage_no)
         logger::error("Could not insert stage");
         return;
     }
+    stage_formids[stage_formid] = stage_no;
+    InvalidateIntegrity();
+    if (listener) listener->OnStageRegistered(slot, stage_formid);
 }
 
 FormID Source::FetchFake(const StageNo st_no) {
@@ -1034,92 +945,28 @@ FormID Source::FetchFake(const StageNo st_no) {
     return new_formid;
 }
 
-StageNo Source::GetLastStageNo() {
-    std::set<StageNo> stage_numbers;
-    for (const auto& key : stages | std::views::keys) {
-		stage_numbers.insert(key);
-	}
-    for (const auto& stage_no : fake_stages) {
-        stage_numbers.insert(stage_no);
-    }
-    if (stage_numbers.empty()) {
-        logger::error("No stages found.");
-        InitFailed();
-		return 0;
-    }
-    // return maximum of the set
-    return *stage_numbers.rbegin();
-}
-
 FormID Source::SearchNearbyModulators(const RE::TESObjectREFR* a_obj, const std::vector<FormID>& candidates) {
-    const auto cell = a_obj->GetParentCell();
-	if (!cell) {
+    if (!a_obj->GetParentCell()) {
 		logger::error("WO and Player cell are null.");
 		return 0;
 	}
-	FormID result = 0;
-	const auto candidates_set = std::set(candidates.begin(), candidates.end());
-    if (cell->IsInteriorCell()) {
-        SearchModulatorInCell(result, a_obj, cell, candidates_set, Settings::search_radius);
-		return result;
-    }
-    SearchModulatorInCell(result, a_obj, cell, candidates_set, Settings::search_radius);
-	if (result) return result;
-
-	// now search in the adjacent cells
-	for (const auto& worldCell : cell->GetRuntimeData().worldSpace->cellMap) {
-		if (!worldCell.second) continue;
-		if (worldCell.second->IsInteriorCell()) continue;
-		if (!AreAdjacentCells(cell,worldCell.second)) continue;
-		SearchModulatorInCell(result, a_obj, worldCell.second, candidates_set, Settings::search_radius);
-		if (result) return result;
-	}
-
-    // now search in skycell
-	if (const auto worldspace = a_obj->GetWorldspace()) {
-		if (const auto skycell = worldspace->GetSkyCell()) {
-			SearchModulatorInCell(result, a_obj, skycell, candidates_set, Settings::search_radius);
-		}
-	}
-
-	return result;
-}
-
-void Source::SearchModulatorInCell(FormID& result, const RE::TESObjectREFR* a_origin,
-                                   const RE::TESObjectCELL* a_cell, const std::set<FormID>& modulators, const float range) {
-    if (range>0) {
-        a_cell->ForEachReferenceInRange(WorldObject::GetPosition(a_origin), range,
-                                        [&result, &modulators](const RE::TESObjectREFR* ref)-> RE::BSContainer::ForEachResult {
-                                            if (!ref || ref->IsDisabled() || ref->IsDeleted() || ref->IsMarkedForDeletion()) return RE::BSContainer::ForEachResult::kContinue;
-                                            if (const auto form_id = ref->GetObjectReference()->GetFormID(); modulators.contains(form_id)) {
-                                                result = form_id;
-                                                return RE::BSContainer::ForEachResult::kStop;
-                                            }
-                                            return RE::BSContainer::ForEachResult::kContinue;
-                                        }
-            );
-    }
-    else {
-		a_cell->ForEachReference(
-			[&a_origin,&result, &modulators](const RE::TESObjectREFR* ref)-> RE::BSContainer::ForEachResult {
-				if (!ref || ref->IsDisabled() || ref->IsDeleted() || ref->IsMarkedForDeletion()) return RE::BSContainer::ForEachResult::kContinue;
-				if (const auto form_id = ref->GetObjectReference()->GetFormID(); modulators.contains(form_id)) {
+    static thread_local std::vector<RefID> nearby;
+    const bool exact = ModulatorGrid::GetSingleton()->GetCandidates(a_obj, Settings::search_radius, candidates, nearby);
+    for (const auto refid : nearby) {
+        const auto ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(refid);
+        if (!ref || ref->IsDisabled() || ref->IsDeleted() || ref->IsMarkedForDeletion()) continue;
+        const auto base = ref->GetObjectReference();
+        if (!base || !Vector::HasElement(candidates, base->GetFormID())) continue;
 #ifndef NDEBUG
-					draw_line(WorldObject::GetPosition(ref), WorldObject::GetPosition(RE::PlayerCharacter::GetSingleton()),3.f, glm::vec4(0.f, 0.f, 1.f, 1.f));
-				    WorldObject::DrawBoundingBox(ref);
+		draw_line(WorldObject::GetPosition(ref), WorldObject::GetPosition(RE::PlayerCharacter::GetSingleton()),3.f, glm::vec4(0.f, 0.f, 1.f, 1.f));
+	    WorldObject::DrawBoundingBox(ref);
 #endif
-                    if (!WorldObject::AreClose(a_origin, ref, Settings::proximity_range)) {
-				        return RE::BSContainer::ForEachResult::kContinue;
-                    }
+        if (!exact && !ModulatorGrid::IsClose(a_obj, ref, Settings::search_radius)) continue;
 #ifndef NDEBUG
-					logger::info("Found modulator in proximity: {}", clib_util::editorID::get_editorID(ref->GetBaseObject()));
+		logger::info("Found modulator in proximity: {}", clib_util::editorID::get_editorID(base));
 #endif
-					result = form_id;
-					return RE::BSContainer::ForEachResult::kStop;
-				}
-				return RE::BSContainer::ForEachResult::kContinue;
-			}
-		);
+        return base->GetFormID();
     }
+	return 0;
 }
 
@@ -1,5 +1,7 @@
 #include "Events.h"
 #include "Threading.h"
+#include "CellScan.h"
+#include "ContainerJournal.h"
 
 void OurEventSink::HandleWO(RE::TESObjectREFR* ref) const
 {
@@ -20,12 +22,15 @@ void OurEventSink::HandleWOsInCell() const
     //M->Update(player);
     const auto player_cell = player->GetParentCell();
 	if (!player_cell) return;
-	player_cell->ForEachReference([this](RE::TESObjectREFR* arg) {
+    std::vector<RE::TESObjectREFR*> refs;
+	player_cell->ForEachReference([&refs](RE::TESObjectREFR* arg) {
 		if (!arg) return RE::BSContainer::ForEachResult::kContinue;
         if (arg->HasContainer()) return RE::BSContainer::ForEachResult::kContinue;
-        this->HandleWO(arg); 
+        if (Settings::IsItem(arg)) refs.push_back(arg);
 		return RE::BSContainer::ForEachResult::kContinue;
     });
+    // spread over the next frames, nearest first
+    CellScan::GetSingleton()->Start(refs, [this](RE::TESObjectREFR* ref) { HandleWO(ref); });
 }
 
 RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESEquipEvent* event, RE::BSTEventSource<RE::TESEquipEvent>*)
@@ -139,6 +144,17 @@ RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESFurnitureEvent*
 
 RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESContainerChangedEvent* event, RE::BSTEventSource<RE::TESContainerChangedEvent>*)
 {
+    // keep the modulator grid in sync with dropped and picked up references, whether we listen or not
+    if (event && event->baseObj && event->oldContainer != event->newContainer) {
+        if (event->oldContainer) M->TouchLocation(event->oldContainer);
+        if (event->newContainer) M->TouchLocation(event->newContainer);
+        if (!event->newContainer) {
+            if (const auto dropped = WorldObject::TryToGetRefFromHandle(event->reference)) ModulatorGrid::GetSingleton()->OnAttach(dropped);
+        }
+        else if (!event->oldContainer) {
+            if (const auto picked = WorldObject::TryToGetRefFromHandle(event->reference)) ModulatorGrid::GetSingleton()->OnDetach(picked->GetFormID());
+        }
+    }
     if (block_eventsinks.load()) return RE::BSEventNotifyControl::kContinue;
     if (!M->listen_container_change.load()) return RE::BSEventNotifyControl::kContinue;
     if (furniture_entered && event->newContainer!=player_refid) return RE::BSEventNotifyControl::kContinue;
@@ -168,16 +184,33 @@ RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESContainerChange
 		//else to_ref = WorldObject::TryToGetRefInCell(event->baseObj,event->itemCount);
     }
 
-	M->Update(from_ref, to_ref, item, event->itemCount);
+    // container to container storms (take all, bulk selling) are netted and applied once per frame
+    if (from_ref && to_ref && from_ref->HasContainer() && to_ref->HasContainer()) {
+        ContainerJournal::GetSingleton()->Record(M, from_ref->GetFormID(), to_ref->GetFormID(), event->baseObj, event->itemCount);
+    }
+	else M->Update(from_ref, to_ref, item, event->itemCount);
 
 	return RE::BSEventNotifyControl::kContinue;
 }
 
+void OurEventSink::HandleTimeJump()
+{
+    const auto t_before = time_jump_start;
+    time_jump_start = 0.f;
+    if (t_before > 0.f) {
+        // the moves of the last frame in place before the containers get advanced
+        ContainerJournal::GetSingleton()->Flush();
+        M->HandleTimeJump(t_before, RE::Calendar::GetSingleton()->GetHoursPassed());
+    }
+    // the time jump only advances what is registered, items lying around in the cell still need their scan
+    HandleWOsInCell();
+}
+
 RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESSleepStopEvent*, RE::BSTEventSource<RE::TESSleepStopEvent>*)
 {
     if (block_eventsinks.load()) return RE::BSEventNotifyControl::kContinue;
     logger::trace("Sleep stop event.");
-    HandleWOsInCell();
+    HandleTimeJump();
     return RE::BSEventNotifyControl::kContinue;
 }
 
@@ -185,7 +218,7 @@ RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESWaitStopEvent*,
 {
     if (block_eventsinks.load()) return RE::BSEventNotifyControl::kContinue;
     logger::trace("Wait stop event.");
-    HandleWOsInCell();
+    HandleTimeJump();
     return RE::BSEventNotifyControl::kContinue;
 }
 
@@ -222,5 +255,25 @@ RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESFormDeleteEvent
     if (!a_event) return RE::BSEventNotifyControl::kContinue;
     if (!a_event->formID) return RE::BSEventNotifyControl::kContinue;
 	M->HandleFormDelete(a_event->formID);
+    ModulatorGrid::GetSingleton()->OnDetach(a_event->formID);
     return RE::BSEventNotifyControl::kContinue;
-}
\ No newline at end of file
+}
+
+RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::TESCellAttachDetachEvent* a_event, RE::BSTEventSource<RE::TESCellAttachDetachEvent>*)
+{
+    if (!a_event || !a_event->reference) return RE::BSEventNotifyControl::kContinue;
+    if (a_event->attached) ModulatorGrid::GetSingleton()->OnAttach(a_event->reference.get());
+    else ModulatorGrid::GetSingleton()->OnDetach(a_event->reference->GetFormID());
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl OurEventSink::ProcessEvent(const RE::MenuOpenCloseEvent* a_event, RE::BSTEventSource<RE::MenuOpenCloseEvent>*)
+{
+    if (block_eventsinks.load()) return RE::BSEventNotifyControl::kContinue;
+    if (!a_event || a_event->menuName != RE::SleepWaitMenu::MENU_NAME) return RE::BSEventNotifyControl::kContinue;
+    const auto now = RE::Calendar::GetSingleton()->GetHoursPassed();
+    if (a_event->opening) time_jump_start = now;
+    // closed without sleeping or waiting, no stop event is coming to use it
+    else if (now <= time_jump_start) time_jump_start = 0.f;
+    return RE::BSEventNotifyControl::kContinue;
+}
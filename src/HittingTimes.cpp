@@ -0,0 +1,155 @@
+#include "HittingTimes.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define HITTING_TIMES_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        // msvc compiles any intrinsic without target flags
+        #define TARGET_SSE
+        #define TARGET_AVX
+    #else
+        #define TARGET_SSE __attribute__((target("sse2")))
+        #define TARGET_AVX __attribute__((target("avx")))
+    #endif
+#endif
+
+namespace {
+    using HittingTimes::SimdLevel;
+
+    SimdLevel DetectSimdLevel() {
+#if defined(HITTING_TIMES_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        const bool has_sse2 = info[3] & (1 << 26);
+        const bool has_avx = info[2] & (1 << 28);
+        // the os has to save the ymm registers too
+        if (const bool has_osxsave = info[2] & (1 << 27); has_avx && has_osxsave && (_xgetbv(0) & 0x6) == 0x6) {
+            return SimdLevel::kAVX;
+        }
+        return has_sse2 ? SimdLevel::kSSE : SimdLevel::kScalar;
+#elif defined(HITTING_TIMES_X86)
+        // also checks that the os saves the ymm registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx")) return SimdLevel::kAVX;
+        return __builtin_cpu_supports("sse2") ? SimdLevel::kSSE : SimdLevel::kScalar;
+#else
+        return SimdLevel::kScalar;
+#endif
+    }
+
+    const SimdLevel simd_level = DetectSimdLevel();
+
+    constexpr float slope_min = -1000.f;
+    constexpr float slope_max = 1000.f;
+    constexpr float slope_eps = std::numeric_limits<float>::epsilon();
+
+    void EvaluateScalar(const float* delay_start, const float* elapsed, const float* delay_mag, const float* schranke,
+                        float* out, const size_t begin, const size_t n) {
+        for (size_t i = begin; i < n; ++i) {
+            const float slope = std::min(std::max(slope_min, delay_mag[i]), slope_max);
+            out[i] = delay_start[i] + (schranke[i] - elapsed[i]) / (slope + slope_eps);
+        }
+    }
+
+#ifdef HITTING_TIMES_X86
+    TARGET_SSE size_t EvaluateSSE(const float* delay_start, const float* elapsed, const float* delay_mag,
+                                  const float* schranke, float* out, const size_t n) {
+        const __m128 lo = _mm_set1_ps(slope_min);
+        const __m128 hi = _mm_set1_ps(slope_max);
+        const __m128 eps = _mm_set1_ps(slope_eps);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 slope = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(delay_mag + i), lo), hi);
+            const __m128 num = _mm_sub_ps(_mm_loadu_ps(schranke + i), _mm_loadu_ps(elapsed + i));
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(delay_start + i), _mm_div_ps(num, _mm_add_ps(slope, eps))));
+        }
+        return i;
+    }
+
+    TARGET_AVX size_t EvaluateAVX(const float* delay_start, const float* elapsed, const float* delay_mag,
+                                  const float* schranke, float* out, const size_t n) {
+        const __m256 lo = _mm256_set1_ps(slope_min);
+        const __m256 hi = _mm256_set1_ps(slope_max);
+        const __m256 eps = _mm256_set1_ps(slope_eps);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256 slope = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(delay_mag + i), lo), hi);
+            const __m256 num = _mm256_sub_ps(_mm256_loadu_ps(schranke + i), _mm256_loadu_ps(elapsed + i));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(delay_start + i), _mm256_div_ps(num, _mm256_add_ps(slope, eps))));
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+
+    TARGET_SSE size_t FlagDueSSE(const float* times, const float curr_time, uint8_t* due, const size_t n) {
+        const __m128 now = _mm_set1_ps(curr_time);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(times + i), now));
+            due[i] = mask & 1;
+            due[i + 1] = (mask >> 1) & 1;
+            due[i + 2] = (mask >> 2) & 1;
+            due[i + 3] = (mask >> 3) & 1;
+        }
+        return i;
+    }
+#endif
+};
+
+void HittingTimes::Evaluate(const float* delay_start, const float* elapsed, const float* delay_mag,
+                            const float* schranke, float* out, const size_t n)
+{
+    Evaluate(simd_level, delay_start, elapsed, delay_mag, schranke, out, n);
+}
+
+void HittingTimes::Evaluate(const SimdLevel a_level, const float* delay_start, const float* elapsed, const float* delay_mag,
+                            const float* schranke, float* out, const size_t n)
+{
+    size_t done = 0;
+    // no fma anywhere, so every path gives the same results as the scalar one
+#ifdef HITTING_TIMES_X86
+    switch (std::min(a_level, simd_level)) {
+        case SimdLevel::kAVX:
+            done = EvaluateAVX(delay_start, elapsed, delay_mag, schranke, out, n);
+            break;
+        case SimdLevel::kSSE:
+            done = EvaluateSSE(delay_start, elapsed, delay_mag, schranke, out, n);
+            break;
+        default:
+            break;
+    }
+#endif
+    EvaluateScalar(delay_start, elapsed, delay_mag, schranke, out, done, n);
+}
+
+void HittingTimes::FlagDue(const float* times, const float curr_time, uint8_t* due, const size_t n)
+{
+    size_t i = 0;
+#ifdef HITTING_TIMES_X86
+    if (simd_level != SimdLevel::kScalar) i = FlagDueSSE(times, curr_time, due, n);
+#endif
+    for (; i < n; ++i) due[i] = times[i] <= curr_time;
+}
+
+HittingTimes::SimdLevel HittingTimes::GetSimdLevel()
+{
+    return simd_level;
+}
+
+const char* HittingTimes::GetSimdLevelName(const SimdLevel a_level)
+{
+    switch (a_level) {
+        case SimdLevel::kAVX:
+            return "AVX";
+        case SimdLevel::kSSE:
+            return "SSE";
+        default:
+            return "Scalar";
+    }
+}
+
+const char* HittingTimes::GetSimdLevelName()
+{
+    return GetSimdLevelName(simd_level);
+}
@@ -1,5 +1,7 @@
 #include "MCP.h"
 #include "SimpleIni.h"
+#include "CellScan.h"
+#include "ContainerJournal.h"
 
 void HelpMarker(const char* desc)
 {
@@ -94,6 +96,40 @@ void __stdcall UI::RenderStatus()
         ImGui::EndTable();
     }
 
+    ImGui::Text(std::format("Tracked Instances: {}/{}", M->GetNInstances(), M->GetInstanceLimit()).c_str());
+    ImGui::Text(std::format("Batch Evaluation: {}", HittingTimes::GetSimdLevelName()).c_str());
+    ImGui::Text(std::format("Inventory Snapshots: {} built for {} lookups", InventorySnapshot::GetNBuilt(),
+                            InventorySnapshot::GetNRequests()).c_str());
+    ImGui::Text(std::format("Tracked Modulator References: {}", ModulatorGrid::GetSingleton()->GetNTracked()).c_str());
+    const auto time_jump = M->GetLastTimeJump();
+    ImGui::Text(std::format("Last Time Jump: {:.2f} h, {}/{} due locations updated, {} at once, in {:.2f} ms", time_jump.hours,
+                            time_jump.n_updated, time_jump.n_due, time_jump.n_jumped, time_jump.ms).c_str());
+    const auto [n_skipped, n_executed] = M->GetUpdateCounters();
+    ImGui::Text(std::format("Ref Updates: {} skipped as up to date, {} executed", n_skipped, n_executed).c_str());
+    ImGui::Text(std::format("Location Snapshots Published: {}", M->GetNLookupPublished()).c_str());
+    const auto journal = ContainerJournal::GetSingleton()->GetStats();
+    ImGui::Text(std::format("Container Changes: {} events, {} moves and {} updates in {} batches ({} early)", journal.events,
+                            journal.moves, journal.updates, journal.flushes, journal.early).c_str());
+    const auto cell_scan = CellScan::GetSingleton()->GetStats();
+    ImGui::Text(std::format("Cell Scan: {} waiting, last frame {} refs in {:.2f} ms ({} refs in {} frames, budget {:.1f} ms)",
+                            cell_scan.backlog, cell_scan.last_slice_done, cell_scan.last_slice_ms, cell_scan.done,
+                            cell_scan.slices, Settings::cell_scan_budget_ms).c_str());
+    if (ImGui::CollapsingHeader("Instances per Source")) {
+        if (ImGui::BeginTable("table_instances", 2, table_flags)) {
+            ImGui::TableSetupColumn("Source");
+            ImGui::TableSetupColumn("Instances");
+            ImGui::TableHeadersRow();
+            for (const auto& [editorid, n] : M->GetNInstancesPerSource()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text(editorid.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text(std::format("{}", n).c_str());
+            }
+            ImGui::EndTable();
+        }
+    }
+
 	ExcludeList();
 }
 void __stdcall UI::RenderInspect()
@@ -212,6 +248,19 @@ void __stdcall UI::RenderUpdateQ()
     ImGui::SameLine();
     HelpMarker("Choosing faster options reduces the time between updates, making the evolution of items out in the world more responsive. It will take time when switching from slower settings.");
 
+	if (ImGui::Checkbox("Sleep Until Next Update", &Settings::ticker_deadline_mode)) {
+		M->SetDeadlineMode(Settings::ticker_deadline_mode);
+		SaveSettings();
+	}
+	ImGui::SameLine();
+	HelpMarker("Instead of checking at the chosen speed, the queue waits until the next world object is due. Objects update closer to their due time and nothing runs while nothing is due. The speed above still sets how often effects are refreshed.");
+
+	const auto stats = M->GetStats();
+	ImGui::Text("Wakeups: %llu, Ticks: %llu", stats.wakeups, stats.ticks);
+	ImGui::Text("Tick Duration (ms): last %.2f, avg %.2f, max %.2f", stats.last_tick.count() / 1000.f,
+	            stats.ticks ? stats.total_tick.count() / 1000.f / static_cast<float>(stats.ticks) : 0.f,
+	            stats.max_tick.count() / 1000.f);
+
 	if (Settings::world_objects_evolve.load()) {
 		ImGui::TextColored(ImVec4(0, 1, 0, 1), "World Objects Evolve: Enabled");
 	}
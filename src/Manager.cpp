@@ -1,4 +1,9 @@
 #include "Manager.h"
+#include "CatchUp.h"
+#include "ContainerJournal.h"
+#include "ModulatorGrid.h"
+#include "TimeJump.h"
+#include <queue>
 #include <unordered_set>
 
 void Manager::WoUpdateLoop(const std::vector<RefID>& refs)
@@ -10,9 +15,9 @@ void Manager::WoUpdateLoop(const std::vector<RefID>& refs)
 				if (!_ref_stops_.contains(refid)) {
 					continue;
 				}
-				auto& val = _ref_stops_.at(refid);
-				PreDeleteRefStop(val, ref->Get3D());
-			    _ref_stops_.erase(refid);
+				const auto it = _ref_stops_.find(refid);
+				PreDeleteRefStop(it->second, ref->Get3D());
+			    EraseRefStop(it);
 			}
 			Update(ref);
 		}
@@ -36,7 +41,7 @@ void Manager::UpdateLoop()
             const auto ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(key);
             PreDeleteRefStop(val, ref ? ref->Get3D() : nullptr);
         }
-        _ref_stops_.clear();
+        ClearRefStops();
     }
 	else if (std::unique_lock lock(queueMutex_);
         !queue_delete_.empty() || !Settings::placed_objects_evolve.load()) {
@@ -45,7 +50,7 @@ void Manager::UpdateLoop()
                 queue_delete_.contains(it->first) ||
                 ref && !Settings::placed_objects_evolve && WorldObject::IsPlacedObject(ref)) {
                 PreDeleteRefStop(it->second,ref ? ref->Get3D() : nullptr);
-	            it = _ref_stops_.erase(it);
+	            it = EraseRefStop(it);
             }
             else ++it;
 	    }
@@ -53,21 +58,51 @@ void Manager::UpdateLoop()
     }
 
 
-    if (_ref_stops_.empty()) {
-        Stop();
-	    std::unique_lock lock(queueMutex_);
-        queue_delete_.clear();
-        return;
+    {
+        // checked and paused under the same lock as QueueWOUpdate adds and resumes, so its Resume can't come in between
+        std::unique_lock lock(queueMutex_);
+        if (_ref_stops_.empty()) {
+            Pause();
+            queue_delete_.clear();
+            return;
+        }
+    }
+
+    // deadlines up to now are tried in this tick. the ones that are still queued after it can't be handled yet,
+    // they don't wake the ticker again and get retried with the next tick
+    if (const auto cal = RE::Calendar::GetSingleton()) {
+        std::unique_lock lock(queueMutex_);
+        last_tick_hours_ = cal->GetHoursPassed();
     }
 
     if (const auto ui = RE::UI::GetSingleton(); ui && ui->GameIsPaused()) return;
 
+    // only the refs that are due or new, and all of them every few ticks to catch time modulators
+    // that were placed/removed nearby and to reapply the effects
+    const auto now = Clock::now();
+    const bool full_sweep = now - last_full_sweep_ >= GetInterval() * full_sweep_every;
+    if (full_sweep) last_full_sweep_ = now;
+
 	std::vector<RefID> ref_stops_copy;
-    for (
-        auto lock = std::shared_lock(queueMutex_);
-        const auto& key : _ref_stops_ | std::views::keys) {
-        ref_stops_copy.push_back(key);
-    } 
+    if (full_sweep) {
+        std::unique_lock lock(queueMutex_);
+        for (const auto& key : _ref_stops_ | std::views::keys) ref_stops_copy.push_back(key);
+        ref_stops_fresh_.clear();
+    }
+    else if (const auto cal = RE::Calendar::GetSingleton()) {
+        const auto curr_time = cal->GetHoursPassed();
+        std::unique_lock lock(queueMutex_);
+        for (const auto& [stop_time, key] : ref_deadlines_) {
+            if (stop_time > curr_time) break;
+            ref_stops_copy.push_back(key);
+        }
+        for (const auto key : ref_stops_fresh_) {
+            if (_ref_stops_.contains(key)) ref_stops_copy.push_back(key);
+        }
+        ref_stops_fresh_.clear();
+        std::ranges::sort(ref_stops_copy);
+        ref_stops_copy.erase(std::ranges::unique(ref_stops_copy).begin(), ref_stops_copy.end());
+    }
 
 	// new mechanic: WO can also be affected by time modulators
 	// Update _ref_stops_ with the new times
@@ -99,7 +134,7 @@ void Manager::UpdateLoop()
 		}
         WoUpdateLoop(ref_stops_copy2);
     }
-    Start();
+    Resume();
 }
 
 void Manager::QueueWOUpdate(const RefStop& a_refstop)
@@ -107,9 +142,74 @@ void Manager::QueueWOUpdate(const RefStop& a_refstop)
     if (!Settings::world_objects_evolve.load()) return;
 	const auto refid = a_refstop.ref_id;
     std::unique_lock lock(queueMutex_);
-    if (_ref_stops_.contains(refid)) _ref_stops_.at(refid).Update(a_refstop);
-    else _ref_stops_[refid] = a_refstop;
-    Start();
+    const bool earlier = SetRefStop(a_refstop);
+    Resume();
+    // in interval mode it just waits for the next tick
+    if (earlier && IsDeadlineMode()) WakeUp();
+}
+
+bool Manager::SetRefStop(const RefStop& a_refstop)
+{
+    const auto refid = a_refstop.ref_id;
+    const auto earliest = ref_deadlines_.empty() ? std::numeric_limits<float>::max() : ref_deadlines_.begin()->first;
+    const auto it = _ref_stops_.find(refid);
+    if (it == _ref_stops_.end()) {
+        _ref_stops_[refid] = a_refstop;
+        ref_deadlines_.insert({a_refstop.stop_time, refid});
+        ref_stops_fresh_.insert(refid);
+        return true;
+    }
+    auto& val = it->second;
+    bool fresh = false;
+    if (val.tint_color.id != a_refstop.tint_color.id || val.art_object.id != a_refstop.art_object.id ||
+        val.effect_shader.id != a_refstop.effect_shader.id || val.sound.id != a_refstop.sound.id) {
+        ref_stops_fresh_.insert(refid);
+        fresh = true;
+    }
+    ref_deadlines_.erase({val.stop_time, refid});
+    val.Update(a_refstop);
+    ref_deadlines_.insert({val.stop_time, refid});
+    return fresh || val.stop_time < earliest;
+}
+
+std::optional<Ticker::Clock::time_point> Manager::GetNextTickTime()
+{
+    const auto now = Clock::now();
+    auto next = last_full_sweep_ + GetInterval() * full_sweep_every;
+
+    std::shared_lock lock(queueMutex_);
+    if (!ref_stops_fresh_.empty()) return now;
+    if (ref_deadlines_.empty()) return next;
+
+    const auto cal = RE::Calendar::GetSingleton();
+    if (!cal) return std::nullopt;
+    const auto timescale = cal->GetTimescale();
+    if (timescale <= 0.f) return next;  // game time is not moving
+
+    // earliest deadline that was not yet due at the last tick
+    const auto first = ref_deadlines_.upper_bound({last_tick_hours_, std::numeric_limits<RefID>::max()});
+    if (first == ref_deadlines_.end()) return next;
+    const auto hours_left = first->first - cal->GetHoursPassed();
+    if (hours_left <= 0.f) return now;
+    // game hours -> real seconds
+    const auto wall = std::chrono::duration<float>(hours_left * 3600.f / timescale);
+    if (wall < next - now) next = now + std::chrono::duration_cast<std::chrono::milliseconds>(wall);
+    return next;
+}
+
+std::map<RefID, RefStop>::iterator Manager::EraseRefStop(const std::map<RefID, RefStop>::iterator it)
+{
+    ref_deadlines_.erase({it->second.stop_time, it->first});
+    ref_stops_fresh_.erase(it->first);
+    return _ref_stops_.erase(it);
+}
+
+void Manager::ClearRefStops()
+{
+    _ref_stops_.clear();
+    ref_deadlines_.clear();
+    ref_stops_fresh_.clear();
+    last_tick_hours_ = -1.f;
 }
 
 void Manager::UpdateRefStop(Source& src, const StageInstance& wo_inst, RefStop& a_ref_stop, const float stop_t) {
@@ -134,25 +234,18 @@ void Manager::UpdateRefStop(Source& src, const StageInstance& wo_inst, RefStop&
 }
 
 
-unsigned int Manager::GetNInstances() {
-    unsigned int n = 0;
-    for (auto& src : sources) {
-        for (const auto& loc : src.data | std::views::keys) {
-            n += static_cast<unsigned int>(src.data[loc].size());
-        }
-    }
-    return n;
-}
-
 Source* Manager::MakeSource(const FormID source_formid, const DefaultSettings* settings)
 {
     if (!source_formid) return nullptr;
     if (IsDynamicFormID(source_formid)) return nullptr;
     // Source new_source(source_formid, "", empty_mgeff, settings);
-    const Source new_source(source_formid, "", settings);
+    Source new_source(source_formid, "", settings);
     if (!new_source.IsHealthy()) return nullptr;
-    sources.push_back(new_source);
-    return &sources.back();
+    auto& src = sources.emplace_back(std::move(new_source));
+    src.Attach(this, sources.size() - 1);
+    ModulatorGrid::GetSingleton()->Track(src.settings.delayers_order);
+    ModulatorGrid::GetSingleton()->Track(src.settings.transformers_order);
+    return &src;
 }
 
 void Manager::CleanUpSourceData(Source* src)
@@ -164,12 +257,135 @@ void Manager::CleanUpSourceData(Source* src)
 Source* Manager::GetSource(const FormID some_formid)
 {
     // maybe it already exists
-    for (auto& src : sources) {
-        if (!src.IsHealthy()) continue;
-        if (src.IsStage(some_formid)) return &src;
+    const auto it = stage_index_.find(some_formid);
+    if (it == stage_index_.end() || it->second >= sources.size()) return nullptr;
+    if (auto& src = sources[it->second]; src.IsHealthy() && src.IsStage(some_formid)) return &src;
+    return nullptr;
+}
+
+void Manager::OnStageRegistered(const SourceSlot a_slot, const FormID a_stage_formid)
+{
+    // first registration wins, same as the order of sources
+    stage_index_.try_emplace(a_stage_formid, a_slot);
+}
+
+void Manager::OnLocationAdded(const SourceSlot a_slot, const RefID a_loc)
+{
+    auto& slots = location_index_[a_loc];
+    if (const auto it = std::ranges::lower_bound(slots, a_slot); it == slots.end() || *it != a_slot) {
+        slots.insert(it, a_slot);
+        lookup_dirty_.store(true);
     }
+    TouchLocation(a_loc);
+}
 
-    return nullptr;
+void Manager::OnLocationRemoved(const SourceSlot a_slot, const RefID a_loc)
+{
+    const auto it = location_index_.find(a_loc);
+    if (it == location_index_.end()) return;
+    std::erase(it->second, a_slot);
+    if (it->second.empty()) {
+        location_index_.erase(it);
+        lookup_dirty_.store(true);
+    }
+    TouchLocation(a_loc);
+}
+
+void Manager::OnInstanceCountChanged(SourceSlot, const std::ptrdiff_t a_delta)
+{
+    n_instances_ = static_cast<size_t>(static_cast<std::ptrdiff_t>(n_instances_) + a_delta);
+}
+
+void Manager::OnLocationChanged(SourceSlot, const RefID a_loc)
+{
+    TouchLocation(a_loc);
+}
+
+void Manager::TouchLocation(const RefID a_loc)
+{
+    std::lock_guard lock(next_due_mutex_);
+    next_due_.erase(a_loc);
+    touch_stamps_.Touch(a_loc);
+}
+
+void Manager::RecordNextDue(RE::TESObjectREFR* a_ref, const float a_curr_time)
+{
+    const auto loc = a_ref->GetFormID();
+    NextDue due{.time = std::numeric_limits<float>::infinity(), .modulator_generation = ModulatorGrid::GetSingleton()->GetGeneration()};
+    for (const auto i : GetSourcesAt(loc)) {
+        if (const auto t = GetEarliestUpdateTime(sources[i], loc); t > 0) due.time = std::min(due.time, t);
+    }
+    // already overdue (e.g. a chain that stopped early): don't cache, the next call has to run
+    if (due.time <= a_curr_time) return;
+    if (!a_ref->HasContainer()) {
+        due.pos = WorldObject::GetPosition(a_ref);
+        if (const auto cell = a_ref->GetParentCell()) due.cell = cell->GetFormID();
+    }
+    std::lock_guard lock(next_due_mutex_);
+    // touched while this update was reading, what it saw might be behind
+    if (const auto token = PendingUpdate::Token(); token && touch_stamps_.TouchedSince(loc, *token)) return;
+    next_due_[loc] = due;
+}
+
+bool Manager::IsUpToDate(RE::TESObjectREFR* a_ref)
+{
+    const auto loc = a_ref->GetFormID();
+    const bool world_object = !a_ref->HasContainer();
+    RE::NiPoint3 pos;
+    FormID cell = 0;
+    if (world_object) {
+        pos = WorldObject::GetPosition(a_ref);
+        if (const auto parent = a_ref->GetParentCell()) cell = parent->GetFormID();
+    }
+    const auto now = RE::Calendar::GetSingleton()->GetHoursPassed();
+    const auto modulator_generation = ModulatorGrid::GetSingleton()->GetGeneration();
+
+    std::lock_guard lock(next_due_mutex_);
+    const auto due = next_due_.find(loc);
+    if (due == next_due_.end()) return false;
+    // stale for good, the update that follows records it anew if it can
+    if (due->second.modulator_generation != modulator_generation || now >= due->second.time ||
+        (world_object && (due->second.cell != cell || due->second.pos.GetDistance(pos) > moved_far_enough))) {
+        next_due_.erase(due);
+        return false;
+    }
+    return true;
+}
+
+void Manager::OnSourceReset(const SourceSlot a_slot)
+{
+    // rare (source failed its integrity check), other sources might share the stage forms
+    RebuildStageIndex();
+    for (auto it = location_index_.begin(); it != location_index_.end();) {
+        if (!std::erase(it->second, a_slot)) {
+            ++it;
+            continue;
+        }
+        // same as OnLocationRemoved for each of them
+        TouchLocation(it->first);
+        if (it->second.empty()) {
+            it = location_index_.erase(it);
+            lookup_dirty_.store(true);
+        }
+        else ++it;
+    }
+}
+
+std::vector<SourceSlot> Manager::GetSourcesAt(const RefID a_loc) const
+{
+    if (const auto it = location_index_.find(a_loc); it != location_index_.end()) return it->second;
+    return {};
+}
+
+void Manager::RebuildStageIndex()
+{
+    stage_index_.clear();
+    for (SourceSlot i = 0; i < sources.size(); ++i) {
+        if (!sources[i].IsHealthy()) continue;
+        for (const auto& stage_formid : sources[i].GetStageFormIDs() | std::views::keys) {
+            stage_index_.try_emplace(stage_formid, i);
+        }
+    }
 }
 
 Source* Manager::ForceGetSource(const FormID some_formid)
@@ -209,7 +425,8 @@ StageInstance* Manager::GetWOStageInstance(const RE::TESObjectREFR* wo_ref)
 {
     if (sources.empty()) return nullptr;
 	const auto wo_refid = wo_ref->GetFormID();
-    for (auto& src : sources) {
+    for (const auto i : GetSourcesAt(wo_refid)) {
+        auto& src = sources[i];
         if (!src.data.contains(wo_refid)) continue;
         auto& instances = src.data.at(wo_refid);
         if (instances.size() == 1)
@@ -253,7 +470,8 @@ void Manager::ApplyStageInWorld(RE::TESObjectREFR* wo_ref, const Stage& stage, R
 	//});
 }
 
-inline void Manager::ApplyEvolutionInInventoryX(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item, FormID new_item)
+inline void Manager::ApplyEvolutionInInventoryX(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item, FormID new_item,
+                                                InventorySnapshot& a_inventory)
 {
     auto* old_bound = RE::TESForm::LookupByID<RE::TESBoundObject>(old_item);
     if (!old_bound) {
@@ -261,7 +479,7 @@ inline void Manager::ApplyEvolutionInInventoryX(RE::TESObjectREFR* inventory_own
         return;
     }
 
-    const auto inventory = inventory_owner->GetInventory();
+    const auto& inventory = a_inventory.Get();
     const auto entry = inventory.find(old_bound);
     if (entry == inventory.end()) {
         logger::error("Item not found in inventory.");
@@ -287,15 +505,18 @@ inline void Manager::ApplyEvolutionInInventoryX(RE::TESObjectREFR* inventory_own
         }
     } else logger::info("original ExtraDataList is null.");
 
-    if (!WorldObject::PlayerPickUpObject(ref_handle, inv_count)) {
+    const bool picked_up = WorldObject::PlayerPickUpObject(ref_handle, inv_count);
+    a_inventory.Invalidate();
+    if (!picked_up) {
         logger::error("Item not picked up.");
         return;
     }
 
-    RemoveItem(inventory_owner, old_item, inv_count);
+    RemoveItem(inventory_owner, old_item, inv_count, &a_inventory);
 }
 
-inline void Manager::ApplyEvolutionInInventory_(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item, FormID new_item)
+inline void Manager::ApplyEvolutionInInventory_(RE::TESObjectREFR* inventory_owner, Count update_count, FormID old_item, FormID new_item,
+                                                InventorySnapshot& a_inventory)
 {
     if (update_count <= 0) {
         logger::error("Update count is 0 or less {}.", update_count);
@@ -307,7 +528,7 @@ inline void Manager::ApplyEvolutionInInventory_(RE::TESObjectREFR* inventory_own
         logger::error("Old item is null.");
         return;
     }
-    const auto inventory = inventory_owner->GetInventory();
+    const auto& inventory = a_inventory.Get();
     const auto entry = inventory.find(old_bound);
     if (entry == inventory.end()) {
         logger::error("Item not found in inventory.");
@@ -326,12 +547,14 @@ inline void Manager::ApplyEvolutionInInventory_(RE::TESObjectREFR* inventory_own
         logger::warn("Item is a quest object.");
         return;
     }
-    RemoveItem(inventory_owner, old_item, std::min(update_count, inv_count));
+    RemoveItem(inventory_owner, old_item, std::min(update_count, inv_count), &a_inventory);
     AddItem(inventory_owner, nullptr, new_item, update_count);
+    a_inventory.Invalidate();
 }
 
 
-void Manager::ApplyEvolutionInInventory(const std::string& _qformtype_, RE::TESObjectREFR* inventory_owner, const Count update_count, const FormID old_item, const FormID new_item)
+void Manager::ApplyEvolutionInInventory(const std::string& _qformtype_, RE::TESObjectREFR* inventory_owner, const Count update_count, const FormID old_item, const FormID new_item,
+                                        InventorySnapshot* a_inventory)
 {
     if (!inventory_owner){
 		logger::error("Inventory owner is null.");
@@ -355,10 +578,12 @@ void Manager::ApplyEvolutionInInventory(const std::string& _qformtype_, RE::TESO
         is_faved = IsPlayerFavorited(RE::TESForm::LookupByID<RE::TESBoundObject>(old_item));
         is_equipped = IsEquipped(RE::TESForm::LookupByID<RE::TESBoundObject>(old_item));
     }
+    InventorySnapshot own_inventory(inventory_owner);
+    auto& inventory = a_inventory && a_inventory->GetOwner() == inventory_owner ? *a_inventory : own_inventory;
     if (is_faved || is_equipped || Vector::HasElement<std::string>(Settings::xQFORMS, _qformtype_)) {
-        ApplyEvolutionInInventoryX(inventory_owner, update_count, old_item, new_item);
+        ApplyEvolutionInInventoryX(inventory_owner, update_count, old_item, new_item, inventory);
     } else {
-        ApplyEvolutionInInventory_(inventory_owner, update_count, old_item, new_item);
+        ApplyEvolutionInInventory_(inventory_owner, update_count, old_item, new_item, inventory);
     }
 
     if (is_faved) FavoriteItem(RE::TESForm::LookupByID<RE::TESBoundObject>(new_item), inventory_owner);
@@ -367,10 +592,11 @@ void Manager::ApplyEvolutionInInventory(const std::string& _qformtype_, RE::TESO
         EquipItem(RE::TESForm::LookupByID<RE::TESBoundObject>(new_item));
         listen_equip.store(true);
     }
+    if (is_faved || is_equipped) inventory.Invalidate();
 }
 
 
-inline void Manager::RemoveItem(RE::TESObjectREFR* moveFrom, const FormID item_id, const Count count)
+inline void Manager::RemoveItem(RE::TESObjectREFR* moveFrom, const FormID item_id, const Count count, InventorySnapshot* a_inventory)
 {
 	if (!moveFrom) {
 		logger::warn("RemoveItem: moveFrom is null.");
@@ -381,7 +607,9 @@ inline void Manager::RemoveItem(RE::TESObjectREFR* moveFrom, const FormID item_i
 		return;
 	}
 
-	const auto inventory = moveFrom->GetInventory();
+	InventorySnapshot own_inventory(moveFrom);
+	auto& snapshot = a_inventory && a_inventory->GetOwner() == moveFrom ? *a_inventory : own_inventory;
+	const auto& inventory = snapshot.Get();
 	if (const auto item = inventory.find(RE::TESForm::LookupByID<RE::TESBoundObject>(item_id)); item != inventory.end()) {
 		if (item->second.second->IsQuestObject()) {
 			logger::warn("Item is a quest object.");
@@ -393,6 +621,7 @@ inline void Manager::RemoveItem(RE::TESObjectREFR* moveFrom, const FormID item_i
 
 		auto* bound = item->first;
 		moveFrom->RemoveItem(bound, count, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
+		snapshot.Invalidate();
 	}
 }
 
@@ -434,88 +663,234 @@ void Manager::Init()
 
     _instance_limit = Settings::nMaxInstances;
 
+    for (SourceSlot i = 0; i < sources.size(); ++i) {
+        sources[i].Attach(this, i);
+        ModulatorGrid::GetSingleton()->Track(sources[i].settings.delayers_order);
+        ModulatorGrid::GetSingleton()->Track(sources[i].settings.transformers_order);
+    }
+
     logger::info("Manager initialized with instance limit {}", _instance_limit);
 }
 
-std::set<float> Manager::GetUpdateTimes(const RE::TESObjectREFR* inventory_owner) {
+float Manager::GetEarliestUpdateTime(Source& src, const RefID loc) {
+    if (!src.IsHealthy()) {
+        logger::error("_UpdateTimeModulators: Source is not healthy.");
+        return 0;
+    }
+    if (!src.data.contains(loc)) return 0;
 
-    std::set<float> queued_updates;
+    static thread_local std::vector<float> hitting_times;
+    src.GetNextUpdateTimes(loc, hitting_times);
+    float earliest = 0;
+    for (const auto hitting_time : hitting_times) {
+        if (hitting_time > 0 && (earliest <= 0 || hitting_time < earliest)) earliest = hitting_time;
+    }
+	return earliest;
+}
 
-	const auto inventory_owner_refid = inventory_owner->GetFormID();
+void Manager::ApplyStageUpdates(Source& src, RE::TESObjectREFR* ref, const std::vector<StageUpdate>& updates, const float t,
+                                InventorySnapshot& a_inventory)
+{
+    const auto refid = ref->GetFormID();
+	for (const auto& update : updates) {
+		ApplyEvolutionInInventory(src.qFormType, ref, update.count, update.oldstage->formid, update.newstage->formid, &a_inventory);
+		if (src.IsDecayedItem(update.newstage->formid)) {
+            Register(update.newstage->formid, update.count, refid, t);
+            a_inventory.Invalidate();  // Register can swap items too
+		}
+	}
+}
 
-    for (auto& src : sources) {
-        if (!src.IsHealthy()) {
-            logger::error("_UpdateTimeModulators: Source is not healthy.");
-			continue;
-        }
-        if (!src.data.contains(inventory_owner_refid)) continue;
+struct Manager::InventoryCatchUp {
+    using Instance = StageInstance;
+    using Slot = SourceSlot;
+    using Inputs = ModulationInputs;
 
-        for (auto& st_inst : src.data.at(inventory_owner_refid)) {
-            if (st_inst.xtra.is_decayed || !src.IsStageNo(st_inst.no)) continue;
-            if (const auto hitting_time = src.GetNextUpdateTime(&st_inst); hitting_time > 0) queued_updates.insert(hitting_time);
-        }
+    Manager& manager;
+    RE::TESObjectREFR* ref;
+    RefID refid;
+    InventorySnapshot& inventory;
+    float curr_time;
+    bool has_container;  // the rest is not modulated
+    std::vector<StageUpdate> updates;  // of the source whose turn it is
+
+    InventoryCatchUp(Manager& a_manager, RE::TESObjectREFR* a_ref, InventorySnapshot& a_inventory, const float a_curr_time)
+        : manager(a_manager), ref(a_ref), refid(a_ref->GetFormID()), inventory(a_inventory), curr_time(a_curr_time),
+          has_container(a_ref->HasContainer()) {}
+
+    [[nodiscard]] std::vector<SourceSlot> SourcesAt() const { return manager.GetSourcesAt(refid); }
+
+    [[nodiscard]] std::vector<StageInstance>* Instances(const SourceSlot i) const {
+        auto& src = manager.sources[i];
+        if (!src.IsHealthy()) return nullptr;
+        const auto it = src.data.find(refid);
+        return it != src.data.end() ? &it->second : nullptr;
     }
 
-	return queued_updates;
-}
+    [[nodiscard]] float NextUpdateTime(const SourceSlot i, StageInstance& inst) const {
+        auto& src = manager.sources[i];
+        if (inst.xtra.is_decayed || !src.IsStageNo(inst.no)) return 0;
+        return src.GetNextUpdateTime(&inst);
+    }
+
+    bool UpdateStage(const SourceSlot i, StageInstance& inst, const float t) {
+        return manager.sources[i].UpdateInstance(refid, inst, t, updates);
+    }
+
+    [[nodiscard]] bool WouldChange(const SourceSlot i, const StageInstance& inst, const float t) const {
+        return manager.sources[i].WouldChange(inst, t);
+    }
+
+    void CleanUp(const SourceSlot i) const { CleanUpSourceData(&manager.sources[i]); }
+
+    bool CleanUpOthers(const SourceSlot i) const { return manager.sources[i].CleanUpData(refid); }
+
+    [[nodiscard]] bool ShouldErase(const SourceSlot i, const StageInstance& inst) const {
+        return manager.sources[i].ShouldErase(inst, curr_time);
+    }
+
+    void Erased(const SourceSlot i, const std::ptrdiff_t n) const { manager.sources[i].FinishCleanUp(refid, n); }
+
+    void ApplyUpdates(const SourceSlot i, const float t) {
+        manager.ApplyStageUpdates(manager.sources[i], ref, updates, t, inventory);
+        updates.clear();
+    }
 
-bool Manager::UpdateInventory(RE::TESObjectREFR* ref, const float t)
+    [[nodiscard]] ModulationInputs GetInputs(const SourceSlot i) const {
+        if (!has_container) return {};
+        return manager.sources[i].GetModulationInputs(ref, inventory);
+    }
+
+    bool Modulate(const SourceSlot i, StageInstance& inst, const ModulationInputs& inputs, const float t) const {
+        return has_container && manager.sources[i].SetDelayOfInstance(inst, t, inputs);
+    }
+
+    void MarkDirty(const SourceSlot i) const { manager.sources[i].MarkDirty(refid); }
+
+    static bool Identical(const StageInstance& a, const StageInstance& b) { return a.Identical(b); }
+};
+
+bool Manager::UpdateInventory(RE::TESObjectREFR* ref, const float t, InventorySnapshot& a_inventory)
 {
-    bool update_took_place = false;
-    const auto refid = ref->GetFormID();
+    InventoryCatchUp model(*this, ref, a_inventory, RE::Calendar::GetSingleton()->GetHoursPassed());
+    return StepInventory(model, t);
+}
 
-    for (size_t i = 0; i < sources.size(); ++i) {
-        auto& src = sources[i];
-        if (!src.IsHealthy()) continue;
-        if (src.data.empty()) continue;
-        if (!src.data.contains(refid)) continue;
-        if (src.data.at(refid).empty()) continue;
-        const auto updated_stages = src.UpdateAllStages({refid}, t);
-		const auto& updates = updated_stages.contains(refid) ? updated_stages.at(refid) : std::vector<StageUpdate>();
-		if (!update_took_place && !updates.empty()) update_took_place = true;
-		CleanUpSourceData(&src);
-#ifndef NDEBUG
-		if (updates.empty()) {
-			logger::trace("UpdateInventory: No updates for source formid {} editorid {}", src.formid, src.editorid);
+struct Manager::TimeJumpModel {
+    using Instance = StageInstance;
+    using Slot = SourceSlot;
+    using Update = StageUpdate;
+
+    Manager& manager;
+    std::map<RefID, InventorySnapshot>& inventories;  // of the containers, synced before the jump
+    float curr_time;
+
+    [[nodiscard]] std::vector<SourceSlot> Sources() const {
+        std::vector<SourceSlot> result;
+        for (SourceSlot i = 0; i < manager.sources.size(); ++i) {
+            if (manager.sources[i].IsHealthy()) result.push_back(i);
         }
-#endif // !NDEBUG
-		for (const auto& update : updates) {
-			ApplyEvolutionInInventory(src.qFormType, ref, update.count, update.oldstage->formid, update.newstage->formid);
-			if (src.IsDecayedItem(update.newstage->formid)) {
-                Register(update.newstage->formid, update.count, refid, t);
-			}
-		}
+        return result;
     }
 
-    for (auto& src : sources) src.UpdateTimeModulationInInventory(ref, t);
+    [[nodiscard]] std::vector<SourceSlot> SourcesAt(const RefID loc) const { return manager.GetSourcesAt(loc); }
 
-    return update_took_place;
-}
+    [[nodiscard]] std::vector<StageInstance>* Instances(const SourceSlot i, const RefID loc) const {
+        auto& src = manager.sources[i];
+        if (!src.IsHealthy()) return nullptr;
+        const auto it = src.data.find(loc);
+        return it != src.data.end() ? &it->second : nullptr;
+    }
 
-void Manager::UpdateInventory(RE::TESObjectREFR* ref)
+    void NextUpdateTimes(const SourceSlot i, const std::vector<RefID>& locs, std::vector<float>& out) const {
+        manager.sources[i].GetNextUpdateTimes(locs, out);
+    }
+
+    bool UpdateStage(const SourceSlot i, const RefID loc, StageInstance& inst, const float t, std::vector<StageUpdate>& out) const {
+        return manager.sources[i].UpdateInstance(loc, inst, t, out);
+    }
+
+    bool Apply(const RefID loc, const std::vector<std::pair<SourceSlot, StageUpdate>>& netted,
+               const std::vector<std::pair<SourceSlot, StageUpdate>>& updates) const {
+        auto& inventory = inventories.at(loc);
+        const auto ref = inventory.GetOwner();
+        for (const auto& [i, update] : netted) {
+            manager.ApplyEvolutionInInventory(manager.sources[i].qFormType, ref, update.count, update.oldstage->formid,
+                                              update.newstage->formid, &inventory);
+        }
+        bool registered = false;
+        for (const auto& [i, update] : updates) {
+            if (!manager.sources[i].IsDecayedItem(update.newstage->formid)) continue;
+            manager.Register(update.newstage->formid, update.count, loc, update.update_time);
+            inventory.Invalidate();  // Register can swap items too
+            registered |= manager.stage_index_.contains(update.newstage->formid);
+        }
+        return registered;
+    }
+
+    void CleanUp(const SourceSlot i) const { CleanUpSourceData(&manager.sources[i]); }
+
+    // UpdateInventory(ref) without the sync, that was done for all of them
+    void CatchUp(const RefID loc) const {
+        auto& inventory = inventories.at(loc);
+        InventoryCatchUp model(manager, inventory.GetOwner(), inventory, curr_time);
+        if (const auto stuck = ::CatchUp(model, curr_time).Run()) {
+            logger::warn("HandleTimeJump: No updates for the time {}", *stuck);
+        }
+        manager.UpdateInventory(inventory.GetOwner(), curr_time, inventory);
+    }
+
+    [[nodiscard]] std::vector<FormID> Produces(const SourceSlot i) const {
+        const auto& src = manager.sources[i];
+        std::vector<FormID> result{src.GetDecayedStage().formid};
+        for (const auto formid : src.GetStageFormIDs() | std::views::keys) result.push_back(formid);
+        for (const auto& transformer : src.settings.transformers | std::views::values) result.push_back(std::get<0>(transformer));
+        return result;
+    }
+
+    [[nodiscard]] std::vector<FormID> Modulators(const SourceSlot i) const {
+        const auto& settings = manager.sources[i].settings;
+        auto result = settings.delayers_order;
+        result.insert(result.end(), settings.transformers_order.begin(), settings.transformers_order.end());
+        return result;
+    }
+
+    [[nodiscard]] std::optional<SourceSlot> SourceOf(const FormID formid) const {
+        if (const auto it = manager.stage_index_.find(formid); it != manager.stage_index_.end()) return it->second;
+        return std::nullopt;
+    }
+
+    [[nodiscard]] bool HasTransformer(const SourceSlot i, const RefID loc) const {
+        auto& inventory = inventories.at(loc);
+        return manager.sources[i].GetModulationInputs(inventory.GetOwner(), inventory).transformer != 0;
+    }
+};
+
+void Manager::UpdateInventory(RE::TESObjectREFR* ref, InventorySnapshot* a_inventory)
 {
+    const PendingUpdate pending(*this);
     listen_container_change.store(false);
 
-	SyncWithInventory(ref);
+    // built once and shared by all sources, rebuilt only after we moved items
+    InventorySnapshot own_inventory(ref);
+    auto& inventory = a_inventory && a_inventory->GetOwner() == ref ? *a_inventory : own_inventory;
+	SyncWithInventory(ref, &inventory);
     
-    // if there are time modulators which can also evolve, they need to be updated first
+    // if there are time modulators which can also evolve, they need to be updated first.
+    // steps through every update time before now, each step only touches the instances that change at it
 	const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
-    while (true){
-		const auto times = GetUpdateTimes(ref);
-		if (times.empty()) break;
-        if (const auto t = *times.begin() + 0.000028f; t >= curr_time) break;
-		else if(!UpdateInventory(ref, t)) {
-			logger::warn("UpdateInventory: No updates for the time {}", t);
-		    break;
-		}
+    InventoryCatchUp model(*this, ref, inventory, curr_time);
+    if (const auto stuck = CatchUp(model, curr_time).Run()) {
+        logger::warn("UpdateInventory: No updates for the time {}", *stuck);
     }
 
-	UpdateInventory(ref, curr_time);
+	UpdateInventory(ref, curr_time, inventory);
+    RecordNextDue(ref, curr_time);
 
 	listen_container_change.store(true);
 }
 
-void Manager::SyncWithInventory(RE::TESObjectREFR* ref)
+void Manager::SyncWithInventory(RE::TESObjectREFR* ref, InventorySnapshot* a_inventory)
 {
 
 	const auto loc_refid = ref->GetFormID();
@@ -525,12 +900,22 @@ void Manager::SyncWithInventory(RE::TESObjectREFR* ref)
     std::unordered_map<FormID, std::vector<StageInstance*>> formid_instances_map = {};
     std::unordered_map<FormID, Count> total_registry_counts = {};
 
-    const auto loc_inventory = ref->GetInventory();
+    InventorySnapshot own_inventory(ref);
+    auto& inventory = a_inventory && a_inventory->GetOwner() == ref ? *a_inventory : own_inventory;
+    // items get added/removed below while this is iterated and Register can swap them through its own snapshot,
+    // so go over a copy of the counts. the shared snapshot is invalidated at the end
+    std::vector<std::pair<RE::TESBoundObject*, Count>> loc_inventory;
+    {
+        const auto& items = inventory.Get();
+        loc_inventory.reserve(items.size());
+        for (const auto& [bound, entry] : items) loc_inventory.emplace_back(bound, entry.first);
+    }
 
     formid_instances_map.reserve(loc_inventory.size());
 	total_registry_counts.reserve(loc_inventory.size());
 
-    for (auto& src : sources) {
+    for (const auto i : GetSourcesAt(loc_refid)) {
+        auto& src = sources[i];
         if (!src.data.contains(loc_refid)) continue;
         for (auto& st_inst : src.data.at(loc_refid)) {  // bu liste onceski savele ayni deil cunku source.datayi
                                                         // _registeratreceivedata deistirdi
@@ -545,13 +930,13 @@ void Manager::SyncWithInventory(RE::TESObjectREFR* ref)
 
 
     if (needHandling) {
-        for (const auto& [bound, entry] : loc_inventory) {
+        for (const auto& [bound, inventory_count] : loc_inventory) {
             if (bound->IsDynamicForm()) {
                 const auto a_formID = bound->GetFormID();
                 auto* name = bound->GetName();
                 const auto nameLen = (name != nullptr) ? std::strlen(name) : 0;
                 if (nameLen == 0) {
-                    RemoveItem(ref, a_formID, std::max(1, entry.first));
+                    RemoveItem(ref, a_formID, std::max(1, inventory_count));
                 }
             }
         }
@@ -560,19 +945,22 @@ void Manager::SyncWithInventory(RE::TESObjectREFR* ref)
     // for every formid, handle the discrepancies
 
 	const auto current_time = RE::Calendar::GetSingleton()->GetHoursPassed();
+    bool inventory_changed = needHandling;
 
-    for (const auto& [bound, entry] : loc_inventory) {
+    for (const auto& [bound, inventory_count] : loc_inventory) {
 		const auto formid = bound->GetFormID();
-		const auto inventory_count = entry.first;
 		if (!formid_instances_map.contains(formid)) {
 			if (inventory_count > 0) {
 				Register(formid, inventory_count, loc_refid, current_time);
+                // can swap items in ApplyEvolutionInInventory
+                inventory_changed = true;
 			}
 		}
         else {
             const auto total_registry_count = total_registry_counts[formid];
             if (auto diff = total_registry_count - inventory_count; diff < 0) {
 			    Register(formid, -diff, loc_refid, current_time);
+                inventory_changed = true;
             }
             else if (diff > 0) {
                 for (auto* instance : formid_instances_map.at(formid)) {
@@ -603,11 +991,16 @@ void Manager::SyncWithInventory(RE::TESObjectREFR* ref)
 		}
     }
 
+    // counts were changed through the pointers above
+    for (const auto i : GetSourcesAt(loc_refid)) sources[i].MarkDirty(loc_refid);
+    if (inventory_changed) inventory.Invalidate();
+
 	locs_to_be_handled.erase(loc_refid);
 }
 
 void Manager::UpdateWO(RE::TESObjectREFR* ref)
 {
+    const PendingUpdate pending(*this);
 	HandleDynamicWO(ref);
     if (!Settings::world_objects_evolve.load()) return;
 	if (ref->IsDeleted() || ref->IsDisabled() || ref->IsMarkedForDeletion()) return;
@@ -618,8 +1011,7 @@ void Manager::UpdateWO(RE::TESObjectREFR* ref)
 	const auto curr_time = RE::Calendar::GetSingleton()->GetHoursPassed();
 	bool not_found = true;
 
-    sources.reserve(sources.size()+1);
-    for (size_t i = 0; i < sources.size(); ++i) {  // NOLINT(modernize-loop-convert)
+    for (const auto i : GetSourcesAt(refid)) {
         auto& src = sources[i];
         if (!src.IsHealthy()) continue;
         if (src.data.empty()) continue;
@@ -642,7 +1034,6 @@ void Manager::UpdateWO(RE::TESObjectREFR* ref)
             }
         }
 
-		//src = sources[i];
 		if (!src.data.contains(refid)) logger::error("UpdateWO: Refid {} not found in source data.", refid);
         auto& wo_inst = src.data.at(refid).front();
         if (wo_inst.xtra.is_fake) ApplyStageInWorld(ref, src.GetStage(wo_inst.no), src.GetBoundObject());
@@ -656,14 +1047,14 @@ void Manager::UpdateWO(RE::TESObjectREFR* ref)
 		break;
     }
 
-    sources.shrink_to_fit();
     if (not_found) Register(ref->GetBaseObject()->GetFormID(), ref->extraList.GetCount(), refid);
+    else RecordNextDue(ref, curr_time);
 }
 
-void Manager::UpdateRef(RE::TESObjectREFR* loc)
+void Manager::UpdateRef(RE::TESObjectREFR* loc, InventorySnapshot* a_inventory)
 {
     if (loc->HasContainer()) {
-        UpdateInventory(loc);
+        UpdateInventory(loc, a_inventory);
     }
 	else UpdateWO(loc);
 
@@ -673,26 +1064,89 @@ void Manager::UpdateRef(RE::TESObjectREFR* loc)
 	//}
 }
 
+void Manager::HandleTimeJump(const float t_before, const float t_after)
+{
+    if (t_after <= t_before) return;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock lock(sourceMutex_);
+    // one columnar pass per source instead of one GetHoursPassed/inventory/cleanup round per location
+    std::vector<RefID> due;
+    std::vector<RefID> src_due;
+    for (auto& src : sources) {
+        if (!src.IsHealthy() || src.data.empty()) continue;
+        src.GetLocationsDueBy(t_after, src_due);
+        due.insert(due.end(), src_due.begin(), src_due.end());
+    }
+    std::ranges::sort(due);
+    due.erase(std::ranges::unique(due).begin(), due.end());
+
+    // inventories first so that items dropped by them are in place for the world objects
+    std::map<RefID, InventorySnapshot> inventories;
+    std::vector<RefID> containers;
+    std::vector<RE::TESObjectREFR*> world_objects;
+    for (const auto refid : due) {
+        const auto ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(refid);
+        if (!ref) continue;
+        if (const auto cell = ref->GetParentCell(); !cell || !cell->IsAttached()) continue;
+        if (!ref->HasContainer()) world_objects.push_back(ref);
+        else {
+            inventories.try_emplace(refid, ref);
+            containers.push_back(refid);
+        }
+    }
+
+    // the containers advance together: per source one batch of next update times over all of them, each due
+    // instance straight to t_after, the changes of a container applied at once
+    const PendingUpdate pending(*this);
+    listen_container_change.store(false);
+    for (auto& inventory : inventories | std::views::values) SyncWithInventory(inventory.GetOwner(), &inventory);
+    TimeJumpModel model{*this, inventories, t_after};
+    TimeJump jump(model, t_after);
+    jump.Run(containers);
+    for (const auto& inventory : inventories | std::views::values) RecordNextDue(inventory.GetOwner(), t_after);
+    listen_container_change.store(true);
+
+    for (const auto ref : world_objects) UpdateWO(ref);
+
+    last_time_jump_.hours = t_after - t_before;
+    last_time_jump_.n_due = due.size();
+    last_time_jump_.n_updated = containers.size() + world_objects.size();
+    last_time_jump_.n_jumped = jump.GetStats().jumped;
+    last_time_jump_.ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    PublishLookup_();
+    logger::info("Time jump of {:.2f} h: {} of {} due locations updated, {} at once, in {:.2f} ms", last_time_jump_.hours,
+                 last_time_jump_.n_updated, last_time_jump_.n_due, last_time_jump_.n_jumped, last_time_jump_.ms);
+}
+
 RefStop* Manager::GetRefStop(const RefID refid)
 {
 	if (!_ref_stops_.contains(refid)) return nullptr;
 	return &_ref_stops_.at(refid);
 }
 
-bool Manager::RefIsRegistered(const RefID refid) {
+bool Manager::RefIsRegistered(const RefID refid) const {
     if (!refid) {
         logger::warn("Refid is null.");
         return false;
     }
+    return lookup_.Load()->locations.contains(refid);
+}
+
+void Manager::PublishLookup()
+{
+    if (!lookup_dirty_.load()) return;
     std::shared_lock lock(sourceMutex_);
-    if (sources.empty()) {
-        logger::warn("Sources is empty.");
-        return false;
-    }
-    for (auto& src : sources) {
-        if (src.data.contains(refid) && !src.data.at(refid).empty()) return true;
-    }
-    return false;
+    PublishLookup_();
+}
+
+void Manager::PublishLookup_()
+{
+    if (!lookup_dirty_.exchange(false)) return;
+    auto snapshot = std::make_shared<LookupSnapshot>();
+    snapshot->locations.reserve(location_index_.size());
+    for (const auto& loc : location_index_ | std::views::keys) snapshot->locations.insert(loc);
+    lookup_.Publish(std::move(snapshot));
 }
 
 void Manager::Register(const FormID some_formid, const Count count, const RefID location_refid, Duration register_time)
@@ -812,7 +1266,8 @@ void Manager::HandleCraftingEnter(unsigned int bench_type)
 
     for (
         std::shared_lock lock(sourceMutex_);
-        auto& src : sources) {
+        const auto i : GetSourcesAt(player_refid)) {
+        auto& src = sources[i];
 		if (!src.IsHealthy()) continue;
         if (!src.data.contains(player_refid)) continue;
         
@@ -856,7 +1311,7 @@ void Manager::HandleCraftingEnter(unsigned int bench_type)
     }
 
 	listen_container_change.store(true);
-
+    PublishLookup();
 }
 
 void Manager::HandleCraftingExit()
@@ -902,9 +1357,96 @@ void Manager::HandleCraftingExit()
 	Update(player_ref);
 }
 
-void Manager::Update(RE::TESObjectREFR* from, RE::TESObjectREFR* to, const RE::TESForm* what, Count count)
+void Manager::Update(RE::TESObjectREFR* from, RE::TESObjectREFR* to, const RE::TESForm* what, const Count count)
 {
+    // container moves of this frame still in the journal come first
+    ContainerJournal::GetSingleton()->FlushIfTouches(from ? from->GetFormID() : 0, to ? to->GetFormID() : 0);
+
+    if (from && !to && !what) {
+        if (IsUpToDate(from)) {
+            ++n_updates_skipped_;
+            return;
+        }
+        ++n_updates_executed_;
+        const PendingUpdate pending(*this);
+        // plain update: the inventory is read before sourceMutex_ is taken, so that it does not block the other updates
+        std::optional<InventorySnapshot> inventory;
+        if (from->HasContainer()) {
+            inventory.emplace(from);
+            std::ignore = inventory->Get();
+        }
+		std::unique_lock lock(sourceMutex_);
+		UpdateRef(from, inventory ? &*inventory : nullptr);
+        lock.unlock();
+        PublishLookup();
+        return;
+    }
 
+    MoveItem(from, to, what, count);
+
+    if (to) UpdateRefIfChanged(to);
+    if (from && (from->HasContainer() || !to)) UpdateRefIfChanged(from);
+    PublishLookup();
+}
+
+bool Manager::UpdateRefIfChanged(RE::TESObjectREFR* a_ref)
+{
+    // the move touched the location if it changed anything we track there
+    if (IsUpToDate(a_ref)) {
+        ++n_updates_skipped_;
+        return false;
+    }
+    ++n_updates_executed_;
+    std::unique_lock lock(sourceMutex_);
+    UpdateRef(a_ref);
+    return true;
+}
+
+bool Manager::ModulatesAt(const FormID a_what, const RefID a_loc) const
+{
+    const auto it = location_index_.find(a_loc);
+    if (it == location_index_.end()) return false;
+    return std::ranges::any_of(it->second, [this, a_what](const SourceSlot i) {
+        const auto& settings = sources[i].settings;
+        return settings.delayers.contains(a_what) || settings.transformers.contains(a_what);
+    });
+}
+
+size_t Manager::Update(const std::vector<ItemMove>& a_moves)
+{
+    // every location once, in the order they were first touched
+    std::vector<RE::TESObjectREFR*> touched;
+    std::unordered_set<RefID> seen;
+    const auto touch = [&](RE::TESObjectREFR* ref) {
+        if (ref && seen.insert(ref->GetFormID()).second) touched.push_back(ref);
+    };
+    for (const auto& [from_refid, to_refid, what_formid, count] : a_moves) {
+        auto* from = from_refid ? RE::TESForm::LookupByID<RE::TESObjectREFR>(from_refid) : nullptr;
+        auto* to = to_refid ? RE::TESForm::LookupByID<RE::TESObjectREFR>(to_refid) : nullptr;
+        MoveItem(from, to, RE::TESForm::LookupByID(what_formid), count);
+        touch(to);
+        if (from && (from->HasContainer() || !to)) touch(from);
+    }
+
+    // the locations the moves left as they were don't need sourceMutex_ unique
+    std::erase_if(touched, [this](RE::TESObjectREFR* ref) {
+        if (!IsUpToDate(ref)) return false;
+        ++n_updates_skipped_;
+        return true;
+    });
+    if (touched.empty()) {
+        PublishLookup();
+        return 0;
+    }
+    n_updates_executed_ += touched.size();
+    std::unique_lock lock(sourceMutex_);
+    for (const auto ref : touched) UpdateRef(ref);
+    PublishLookup_();
+    return touched.size();
+}
+
+void Manager::MoveItem(RE::TESObjectREFR*& from, RE::TESObjectREFR*& to, const RE::TESForm* what, Count count)
+{
     const bool to_is_world_object = to && !to->HasContainer();
     if (to_is_world_object) count = to->extraList.GetCount();
 
@@ -922,9 +1464,21 @@ void Manager::Update(RE::TESObjectREFR* from, RE::TESObjectREFR* to, const RE::T
 
     if (!to && what && what->Is(RE::FormType::AlchemyItem)) count = 0;
 
-    if (what && count > 0) {
-		std::unique_lock lock(sourceMutex_);
-        if (const auto src = GetSource(what->GetFormID())) {
+    if (!what || count <= 0) return;
+
+    // check phase: most items are not tracked, those only matter if they modulate something at either end
+    std::shared_lock check(sourceMutex_);
+    const bool tracked = GetSource(what->GetFormID()) != nullptr;
+    const bool modulates_from = !tracked && from && ModulatesAt(what->GetFormID(), from->GetFormID());
+    const bool modulates_to = !tracked && to && ModulatesAt(what->GetFormID(), to->GetFormID());
+    check.unlock();
+    if (modulates_from) TouchLocation(from->GetFormID());
+    if (modulates_to) TouchLocation(to->GetFormID());
+    if (!tracked) return;
+
+	std::unique_lock lock(sourceMutex_);
+    // looked up again, a source can have been reset in between
+    if (const auto src = GetSource(what->GetFormID())) {
 			logger::trace("Update: Source found for {}.", what->GetName());
 	        const auto from_refid = from ? from->GetFormID() : 0;
 	        const auto to_refid = to ? to->GetFormID() : 0;
@@ -961,16 +1515,6 @@ void Manager::Update(RE::TESObjectREFR* from, RE::TESObjectREFR* to, const RE::T
                     else logger::error("Update: New ref is null.");
 		        }
             }
-		}
-	}
-
-    if (to) {
-		std::unique_lock lock(sourceMutex_);
-        UpdateRef(to);
-    }
-    if (from && (from->HasContainer() || !to)) {
-		std::unique_lock lock(sourceMutex_);
-		UpdateRef(from);
 	}
 }
 
@@ -995,16 +1539,30 @@ void Manager::SwapWithStage(RE::TESObjectREFR* wo_ref)
 void Manager::Reset()
 {
     logger::info("Resetting manager...");
-	Stop();
+	Pause();
 	ClearWOUpdateQueue();
-    for (auto& src : sources) src.Reset();
+    for (auto& src : sources) {
+        src.Attach(nullptr, 0);
+        src.Reset();
+    }
     sources.clear();
+    stage_index_.clear();
+    location_index_.clear();
+    n_instances_ = 0;
+    ModulatorGrid::GetSingleton()->Clear();
+    {
+        std::lock_guard lock(next_due_mutex_);
+        next_due_.clear();
+        touch_stamps_.clear();
+    }
     // external_favs.clear();         // we will update this in ReceiveData
     handle_crafting_instances.clear();
     faves_list.clear();
     equipped_list.clear();
     locs_to_be_handled.clear();
     Clear();
+    lookup_dirty_.store(true);
+    PublishLookup();
 	listen_container_change.store(true);
 	isUninstalled.store(false);
     
@@ -1014,14 +1572,16 @@ void Manager::Reset()
 void Manager::HandleFormDelete(const FormID a_refid)
 {
 
-    for (auto& src : sources) {
-        if (src.data.contains(a_refid)) {
+    for (const auto i : GetSourcesAt(a_refid)) {
+        if (auto& src = sources[i]; src.data.contains(a_refid)) {
             logger::warn("HandleFormDelete: Formid {}", a_refid);
             for (auto& st_inst : src.data.at(a_refid)) {
                 st_inst.count = 0;
             }
+            src.MarkDirty(a_refid);
         }
     }
+    PublishLookup();
 }
 
 void Manager::SendData()
@@ -1140,7 +1700,7 @@ StageInstance* Manager::RegisterAtReceiveData(const FormID source_formid, const
         StageInstance new_instance(st_plain.start_time, stage_no, st_plain.count);
         const auto& stage_temp = src->GetStage(stage_no);
         new_instance.xtra.form_id = stage_temp.formid;
-        new_instance.xtra.editor_id = clib_util::editorID::get_editorID(stage_temp.GetBound());
+        new_instance.xtra.editor_id = src->GetStageEditorID(stage_temp);
         new_instance.xtra.crafting_allowed = stage_temp.crafting_allowed;
         if (src->IsFakeStage(stage_no)) new_instance.xtra.is_fake = true;
 
@@ -1246,6 +1806,7 @@ void Manager::ReceiveData()
         }
         Print();
     }
+    PublishLookup();
 
     logger::info("--------Data received. Number of instances: {}---------", n_instances);
 }
@@ -1284,6 +1845,7 @@ void Manager::HandleWOBaseChange(RE::TESObjectREFR* ref)
 		if (!st_inst || st_inst->count <= 0) return;
         if (const auto* bound_expected = src->IsFakeStage(st_inst->no) ? src->GetBoundObject() : st_inst->GetBound(); bound_expected->GetFormID() != bound->GetFormID()) {
 	        st_inst->count = 0;
+            for (const auto i : GetSourcesAt(ref->GetFormID())) sources[i].MarkDirty(ref->GetFormID());
 			std::unique_lock lock(queueMutex_);
 			queue_delete_.insert(ref->GetFormID());
         }
@@ -0,0 +1,184 @@
+#include "ModulatorGrid.h"
+#include "Settings.h"
+
+void ModulatorGrid::Track(const std::vector<FormID>& a_bases)
+{
+    std::lock_guard lock(mutex_);
+    bool added = false;
+    for (const auto base : a_bases) {
+        if (base && tracked_.insert(base).second) added = true;
+    }
+    if (added) scanned_spaces_.clear();
+}
+
+void ModulatorGrid::OnAttach(const RE::TESObjectREFR* a_ref)
+{
+    if (!a_ref) return;
+    std::lock_guard lock(mutex_);
+    Add(a_ref);
+}
+
+void ModulatorGrid::OnDetach(const RefID a_refid)
+{
+    std::lock_guard lock(mutex_);
+    if (grid_.Erase(a_refid)) ++generation_;
+}
+
+void ModulatorGrid::Clear()
+{
+    std::lock_guard lock(mutex_);
+    grid_.Clear();
+    scanned_spaces_.clear();
+    ++generation_;
+}
+
+size_t ModulatorGrid::GetNTracked()
+{
+    std::lock_guard lock(mutex_);
+    return grid_.size();
+}
+
+bool ModulatorGrid::GetCandidates(const RE::TESObjectREFR* a_origin, const float a_range, const std::vector<FormID>& a_bases,
+                                  std::vector<RefID>& out)
+{
+    out.clear();
+    const auto space = GetSpace(a_origin);
+    if (!space) return false;
+
+    static thread_local std::vector<SpatialHashGrid::Entry> entries;
+    const auto pos = WorldObject::GetPosition(a_origin);
+    {
+        std::lock_guard lock(mutex_);
+        if (const auto it = batch_.find(a_origin->GetFormID()); it != batch_.end()) {
+            for (const auto refid : it->second) {
+                if (const auto entry = grid_.Find(refid); entry && Vector::HasElement(a_bases, entry->base)) out.push_back(refid);
+            }
+            return true;
+        }
+        if (!scanned_spaces_.contains(space)) {
+            ScanSpace(a_origin);
+            scanned_spaces_.insert(space);
+        }
+        const float range = a_range > 0 ? a_range : Settings::proximity_range + GetRadius(a_origin) + grid_.GetMaxRadius();
+        grid_.Query(space, pos.x, pos.y, pos.z, range + position_slack, a_bases, entries);
+    }
+    out.reserve(entries.size());
+    for (const auto& entry : entries) out.push_back(entry.refid);
+    return false;
+}
+
+void ModulatorGrid::BeginBatch(const std::vector<const RE::TESObjectREFR*>& a_objects, const float a_range)
+{
+    std::lock_guard lock(mutex_);
+    batch_.clear();
+
+    std::vector<SweepAndPrune::Box> object_boxes;
+    std::vector<const RE::TESObjectREFR*> objects;
+    object_boxes.reserve(a_objects.size());
+    objects.reserve(a_objects.size());
+    // boxes of half extent e1 and e2 overlap whenever the centers are within e1 + e2 on every axis
+    const float half_range = (a_range > 0 ? a_range : Settings::proximity_range) / 2.f + position_slack;
+    for (const auto obj : a_objects) {
+        const auto space = obj ? GetSpace(obj) : 0;
+        if (!space) continue;
+        if (!scanned_spaces_.contains(space)) {
+            ScanSpace(obj);
+            scanned_spaces_.insert(space);
+        }
+        const auto pos = WorldObject::GetPosition(obj);
+        const float half = half_range + (a_range > 0 ? 0.f : GetRadius(obj));
+        object_boxes.push_back(SweepAndPrune::Around(space, pos.x, pos.y, pos.z, half));
+        objects.push_back(obj);
+        batch_[obj->GetFormID()];
+    }
+
+    std::vector<SweepAndPrune::Box> modulator_boxes;
+    std::vector<RefID> modulators;
+    modulator_boxes.reserve(grid_.size());
+    modulators.reserve(grid_.size());
+    grid_.ForEach([&](const SpatialHashGrid::Entry& e) {
+        const float half = half_range + (a_range > 0 ? 0.f : e.radius);
+        modulator_boxes.push_back(SweepAndPrune::Around(e.space, e.x, e.y, e.z, half));
+        modulators.push_back(e.refid);
+    });
+
+    std::unordered_map<RefID, std::vector<std::pair<float, RefID>>> hits;
+    SweepAndPrune::Pairs(object_boxes, modulator_boxes, [&](const size_t i, const size_t j) {
+        const auto modulator = RE::TESForm::LookupByID<RE::TESObjectREFR>(modulators[j]);
+        if (!modulator || modulator->IsDisabled() || modulator->IsDeleted() || modulator->IsMarkedForDeletion()) return;
+        if (!IsClose(objects[i], modulator, a_range)) return;
+        const auto distance = WorldObject::GetPosition(objects[i]).GetDistance(modulator->GetPosition());
+        hits[objects[i]->GetFormID()].emplace_back(distance, modulators[j]);
+    });
+    for (auto& [refid, found] : hits) {
+        std::ranges::sort(found);
+        auto& result = batch_[refid];
+        result.reserve(found.size());
+        for (const auto& modulator : found | std::views::values) result.push_back(modulator);
+    }
+}
+
+void ModulatorGrid::EndBatch()
+{
+    std::lock_guard lock(mutex_);
+    batch_.clear();
+}
+
+bool ModulatorGrid::IsClose(const RE::TESObjectREFR* a_origin, const RE::TESObjectREFR* a_modulator, const float a_range)
+{
+    if (a_range > 0) return WorldObject::GetPosition(a_origin).GetDistance(a_modulator->GetPosition()) <= a_range;
+    return WorldObject::AreClose(a_origin, a_modulator, Settings::proximity_range);
+}
+
+FormID ModulatorGrid::GetSpace(const RE::TESObjectREFR* a_ref)
+{
+    const auto cell = a_ref->GetParentCell();
+    if (!cell) return 0;
+    if (cell->IsInteriorCell()) return cell->GetFormID();
+    const auto worldspace = a_ref->GetWorldspace();
+    return worldspace ? worldspace->GetFormID() : 0;
+}
+
+float ModulatorGrid::GetRadius(const RE::TESObjectREFR* a_ref)
+{
+    // same bounds as WorldObject::AreClose uses, so the query range covers them
+    const auto [min, max] = WorldObject::GetLocalBounds(a_ref);
+    const RE::NiPoint3 extent(std::max(fabs(min.x), fabs(max.x)), std::max(fabs(min.y), fabs(max.y)),
+                              std::max(fabs(min.z), fabs(max.z)));
+    return extent.Length() * a_ref->GetScale();
+}
+
+void ModulatorGrid::Add(const RE::TESObjectREFR* a_ref)
+{
+    const auto base = a_ref->GetObjectReference();
+    if (!base || !tracked_.contains(base->GetFormID())) return;
+    if (a_ref->IsDisabled() || a_ref->IsDeleted() || a_ref->IsMarkedForDeletion()) return;
+    const auto space = GetSpace(a_ref);
+    if (!space) return;
+    const auto pos = WorldObject::GetPosition(a_ref);
+    grid_.Insert({a_ref->GetFormID(), base->GetFormID(), space, pos.x, pos.y, pos.z, GetRadius(a_ref)});
+    ++generation_;
+}
+
+void ModulatorGrid::ScanCell(const RE::TESObjectCELL* a_cell)
+{
+    a_cell->ForEachReference([this](const RE::TESObjectREFR* ref) {
+        if (ref) Add(ref);
+        return RE::BSContainer::ForEachResult::kContinue;
+    });
+}
+
+void ModulatorGrid::ScanSpace(const RE::TESObjectREFR* a_origin)
+{
+    const auto cell = a_origin->GetParentCell();
+    if (!cell) return;
+    if (cell->IsInteriorCell()) return ScanCell(cell);
+
+    const auto worldspace = a_origin->GetWorldspace();
+    if (!worldspace) return ScanCell(cell);
+    // only on the first query in the worldspace, the attach events take over from there
+    for (const auto& world_cell : worldspace->cellMap) {
+        if (world_cell.second && world_cell.second->IsAttached()) ScanCell(world_cell.second);
+    }
+    if (const auto skycell = worldspace->GetSkyCell()) ScanCell(skycell);
+}
@@ -970,6 +970,10 @@ void LoadINISettings()
 
     Settings::nForgettingTime = std::min(Settings::nForgettingTime, 4320);
 
+    if (!ini.KeyExists("Other Settings", "fCellScanBudgetMs")) {
+        ini.SetDoubleValue("Other Settings", "fCellScanBudgetMs", Settings::cell_scan_budget_ms);
+    } else Settings::cell_scan_budget_ms = static_cast<float>(ini.GetDoubleValue("Other Settings", "fCellScanBudgetMs", Settings::cell_scan_budget_ms));
+
     Settings::disable_warnings = ini.GetBoolValue("Other Settings", "DisableWarnings", Settings::disable_warnings);
     Settings::world_objects_evolve = ini.GetBoolValue("Other Settings", "WorldObjectsEvolve", Settings::world_objects_evolve);
 	Settings::placed_objects_evolve = ini.GetBoolValue("Other Settings", "PlacedObjectsEvolve", Settings::placed_objects_evolve);
@@ -1004,6 +1008,10 @@ void LoadJSONSettings()
 		return;
 	}
 	Settings::ticker_speed = Settings::Ticker::from_string(ticker["speed"].GetString());
+	// older files don't have it
+	if (ticker.HasMember("deadline_mode") && ticker["deadline_mode"].IsBool()) {
+		Settings::ticker_deadline_mode = ticker["deadline_mode"].GetBool();
+	}
 }
 
 void LoadSettings() {
@@ -1175,5 +1183,6 @@ rapidjson::Value Settings::Ticker::to_json(rapidjson::Document::AllocatorType& a
     const std::string speed_str = Ticker::to_string(ticker_speed);
     Value speed_value(speed_str.c_str(), a);
     ticker.AddMember("speed", speed_value, a); 
+    ticker.AddMember("deadline_mode", ticker_deadline_mode, a);
     return ticker;
 }
@@ -1,16 +1,44 @@
 #include "Ticker.h"
 
-void Ticker::Start()
+void Ticker::Resume()
 {
-	if (m_Running) {
-        return;
+    {
+        std::lock_guard lock(m_WakeMutex);
+        if (m_Shutdown || m_Running) return;
+        m_Running = true;
+        if (!m_Thread.joinable()) {
+            m_Thread = std::thread(&Ticker::RunLoop, this);
+            return;
+        }
+    }
+    m_WakeCV.notify_one();
+}
+
+void Ticker::Pause()
+{
+    {
+        std::lock_guard lock(m_WakeMutex);
+        m_Running = false;
     }
-    m_Running = true;
-    // logger::info("Start Called with thread active state of: {}", m_ThreadActive);
-    if (!m_ThreadActive) {
-        std::thread tickerThread(&Ticker::RunLoop, this);
-        tickerThread.detach();
+    m_WakeCV.notify_one();
+}
+
+void Ticker::RequestShutdown()
+{
+    {
+        std::lock_guard lock(m_WakeMutex);
+        m_Shutdown = true;
+        m_Running = false;
     }
+    m_WakeCV.notify_one();
+}
+
+void Ticker::Shutdown()
+{
+    RequestShutdown();
+    if (!m_Thread.joinable()) return;
+    if (m_Thread.get_id() == std::this_thread::get_id()) m_Thread.detach();
+    else m_Thread.join();
 }
 
 void Ticker::UpdateInterval(const std::chrono::milliseconds newInterval)
@@ -18,18 +46,82 @@ void Ticker::UpdateInterval(const std::chrono::milliseconds newInterval)
     m_IntervalMutex.lock();
     m_Interval = newInterval;
     m_IntervalMutex.unlock();
+    WakeUp();
+}
+
+void Ticker::SetDeadlineMode(const bool a_enabled)
+{
+    m_DeadlineMode = a_enabled;
+    WakeUp();
+}
+
+void Ticker::WakeUp()
+{
+    {
+        std::lock_guard lock(m_WakeMutex);
+        m_WakeRequested = true;
+    }
+    m_WakeCV.notify_one();
+}
+
+Ticker::Stats Ticker::GetStats()
+{
+    std::lock_guard lock(m_StatsMutex);
+    return m_Stats;
+}
+
+std::chrono::milliseconds Ticker::GetInterval()
+{
+    std::lock_guard lock(m_IntervalMutex);
+    return m_Interval;
 }
 
 void Ticker::RunLoop()
 {
-    m_ThreadActive = true;
-    while (m_Running) {
+    while (true) {
+        {
+            // parked while paused
+            std::unique_lock lock(m_WakeMutex);
+            if (!m_Running && !m_Shutdown) {
+                m_WakeCV.wait(lock, [this] { return m_Running || m_Shutdown; });
+                std::lock_guard stats_lock(m_StatsMutex);
+                ++m_Stats.wakeups;
+            }
+            if (m_Shutdown) return;
+            m_WakeRequested = false;
+        }
+
+        const auto tick_start = Clock::now();
         m_OnTick();
         {
-            std::lock_guard lock(m_IntervalMutex);
-            std::chrono::milliseconds interval = m_Interval;
-            std::this_thread::sleep_for(interval);
+            const auto took = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tick_start);
+            std::lock_guard lock(m_StatsMutex);
+            ++m_Stats.ticks;
+            m_Stats.last_tick = took;
+            m_Stats.max_tick = std::max(m_Stats.max_tick, took);
+            m_Stats.total_tick += took;
         }
+        if (!m_Running) continue;
+
+        // computed before taking m_WakeMutex: GetNextTickTime may lock things that WakeUp gets called under
+        const auto now = Clock::now();
+        auto wake_at = now + GetInterval();
+        if (m_DeadlineMode) {
+            if (const auto next = GetNextTickTime(); next && *next > now) {
+                wake_at = *next;
+                m_Backoff = min_backoff;
+            }
+            else if (next) {
+                wake_at = now + m_Backoff;
+                m_Backoff = std::min(m_Backoff * 2, GetInterval());
+            }
+        }
+
+        // a WakeUp that came in during the tick is not lost, the flag is still set
+        std::unique_lock lock(m_WakeMutex);
+        m_WakeCV.wait_until(lock, wake_at, [this] { return m_WakeRequested || !m_Running || m_Shutdown; });
+        m_WakeRequested = false;
+        std::lock_guard stats_lock(m_StatsMutex);
+        ++m_Stats.wakeups;
     }
-    m_ThreadActive = false;
-}
\ No newline at end of file
+}
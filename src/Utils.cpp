@@ -25,6 +25,43 @@ bool Types::FormEditorIDX::operator==(const FormEditorIDX& other) const
     return form_id == other.form_id;
 }
 
+EditorIDPool::ID EditorIDPool::Intern(const std::string_view a_editorid)
+{
+    if (a_editorid.empty()) return 0;
+    if (const auto id = Find(a_editorid)) return id;
+
+    std::unique_lock lock(mutex_);
+    if (const auto it = ids_.find(a_editorid); it != ids_.end()) return it->second;
+    const auto id = static_cast<ID>(strings_.size());
+    const auto& stored = strings_.emplace_back(a_editorid);
+    ids_.emplace(stored, id);
+    return id;
+}
+
+EditorIDPool::ID EditorIDPool::Intern(const RE::TESForm* a_form)
+{
+    if (!a_form) return 0;
+    return Intern(clib_util::editorID::get_editorID(a_form));
+}
+
+EditorIDPool::ID EditorIDPool::Find(const std::string_view a_editorid) const
+{
+    if (a_editorid.empty()) return 0;
+    std::shared_lock lock(mutex_);
+    if (const auto it = ids_.find(a_editorid); it != ids_.end()) return it->second;
+    return 0;
+}
+
+const std::string& EditorIDPool::Resolve(const ID a_id) const
+{
+    std::shared_lock lock(mutex_);
+    if (a_id >= strings_.size()) {
+        logger::error("EditorIDPool: Unknown id {}.", a_id);
+        return strings_.front();
+    }
+    return strings_[a_id];
+}
+
 void SetupLog()
 {
     const auto logsFolder = SKSE::log::log_directory();
@@ -692,11 +729,11 @@ std::array<RE::NiPoint3, 8> WorldObject::GetBoundingBox(const RE::TESObjectREFR*
 {
     //using namespace Math::LinAlg;
     const auto center = GetPosition(a_obj);
-	const Math::LinAlg::Geometry geometry(a_obj);
-	auto [min, max] = geometry.GetBoundingBox();
+	auto [min, max] = GetLocalBounds(a_obj);
+	const auto scale = a_obj->GetScale();
 
-	min = center + min;
-	max = center + max;
+	min = center + min * scale;
+	max = center + max * scale;
 
 	const auto obj_angle = a_obj->GetAngle();
 
@@ -822,80 +859,45 @@ bool WorldObject::IsInTriangle(const RE::NiPoint3& A, const RE::NiPoint3& B, con
 }
 
 namespace {
-    bool Is2DBoundingBox(const std::array<RE::NiPoint3,8>& a_bounding_box) {
-        // const auto v1 = rotate(RE::NiPoint3(min.x, min.y, min.z) - center, obj_angle) + center;
-	    //const auto v2 = rotate(RE::NiPoint3(max.x, min.y, min.z) - center, obj_angle) + center;
-	    //const auto v3 = rotate(RE::NiPoint3(max.x, max.y, min.z) - center, obj_angle) + center;
-	    //const auto v4 = rotate(RE::NiPoint3(min.x, max.y, min.z) - center, obj_angle) + center;
-
-	    //const auto v5 = rotate(RE::NiPoint3(min.x, min.y, max.z) - center, obj_angle) + center;
-	    //const auto v6 = rotate(RE::NiPoint3(max.x, min.y, max.z) - center, obj_angle) + center;
-	    //const auto v7 = rotate(RE::NiPoint3(max.x, max.y, max.z) - center, obj_angle) + center;
-	    //const auto v8 = rotate(RE::NiPoint3(min.x, max.y, max.z) - center, obj_angle) + center;
-
-	    const auto& v1 = a_bounding_box[0];
-	    const auto& v5 = a_bounding_box[4];
-	    if (const auto diff = fabs(v1.z - v5.z); diff > 1.f) {
-		    return false;
-	    }
-	    return true;
+    // unscaled local bounds of the loaded model per base form. only filled from real vertices,
+    // so refs without 3D yet get their bounds recomputed once the model is there
+    std::shared_mutex local_bounds_mutex;
+    std::unordered_map<FormID, std::pair<RE::NiPoint3, RE::NiPoint3>> local_bounds;
+};
 
+std::pair<RE::NiPoint3, RE::NiPoint3> WorldObject::GetLocalBounds(const RE::TESObjectREFR* a_obj)
+{
+    const auto base = a_obj->GetObjectReference();
+    const FormID base_id = base ? base->GetFormID() : 0;
+    if (base_id) {
+        std::shared_lock lock(local_bounds_mutex);
+        if (const auto it = local_bounds.find(base_id); it != local_bounds.end()) return it->second;
     }
-
-	bool IsOn2DBoundingBox(const std::array<RE::NiPoint3, 4>& a_box, const RE::NiPoint3& a_point) {
-	    auto n_x = a_box[1] - a_box[0];
-	    auto n_y = a_box[3] - a_box[0];
-	    const auto width = n_x.Length();
-	    const auto length = n_y.Length();
-	    n_x /= width;
-	    n_y /= length;
-	    const auto v_rel = a_point - a_box[0];
-	    if (const auto comp = n_x.Dot(v_rel); comp > width || comp < 0.f) {
-		    return false;
-	    }
-	    if (const auto comp = n_y.Dot(v_rel); comp > length || comp < 0.f) {
-		    return false;
-	    }
-	    return true;
+    const Math::LinAlg::Geometry geometry(a_obj);
+    auto bounds = geometry.GetLocalBoundingBox();
+    if (base_id && geometry.HasVertices()) {
+        std::unique_lock lock(local_bounds_mutex);
+        local_bounds.try_emplace(base_id, bounds);
     }
+    return bounds;
+}
 
-    RE::NiPoint3 GetClosestPoint2D(const std::array<RE::NiPoint3,4>& a_2d_bounded_plane, const RE::NiPoint3& a_outside_point) {
-
-        const auto v_normal = Math::LinAlg::CalculateNormalOfPlane(a_2d_bounded_plane[1] - a_2d_bounded_plane[0], a_2d_bounded_plane[2] - a_2d_bounded_plane[0]);
-	    const auto closest_point = Math::LinAlg::closestPointOnPlane(a_2d_bounded_plane[0], a_outside_point, v_normal);
-		if (IsOn2DBoundingBox(a_2d_bounded_plane, closest_point)) {
-			return closest_point;
-		}
-		const auto closest = Math::LinAlg::GetClosest3Vertices(a_2d_bounded_plane, closest_point);
-        if (WorldObject::IsInTriangle(closest[0], closest[1], closest[2], closest_point)) {
-			return closest_point;
-		}
-        return Math::LinAlg::intersectLine(closest,closest_point);
-    }
-};
 
 RE::NiPoint3 WorldObject::GetClosestPoint(const RE::NiPoint3& a_point_from, const RE::TESObjectREFR* a_obj_to)
 {
-    const auto bounding_box = GetBoundingBox(a_obj_to);
-	if (Is2DBoundingBox(bounding_box)) {
-	    const std::array a_2d_bounded_plane = {bounding_box[0],bounding_box[1],bounding_box[2],bounding_box[3]};
-        return GetClosestPoint2D(a_2d_bounded_plane,a_point_from);
-	}
-	if (IsInBoundingBox(bounding_box, a_point_from)) {
-		return a_point_from;
-	}
-	const auto closest = Math::LinAlg::GetClosest3Vertices(bounding_box,a_point_from);
-	const auto v_normal = Math::LinAlg::CalculateNormalOfPlane(closest[1] - closest[0], closest[2] - closest[0]);
-	const auto closest_point = Math::LinAlg::closestPointOnPlane(closest[0], a_point_from, v_normal);
-#ifndef NDEBUG
-	draw_line(closest[0], closest[1], 3,glm::vec4(0.f,1.f,0.f,1.f));
-    draw_line(closest[1], closest[2], 3,glm::vec4(0.f,1.f,0.f,1.f));
-    draw_line(closest[2], closest[0], 3,glm::vec4(0.f,1.f,0.f,1.f));
-#endif
-    if (IsInTriangle(closest[0], closest[1], closest[2], closest_point)) {
-		return closest_point;
-	}
-	return Math::LinAlg::intersectLine(closest,closest_point);
+    auto [min, max] = GetLocalBounds(a_obj_to);
+    const auto scale = a_obj_to->GetScale();
+    min *= scale;
+    max *= scale;
+    const auto center = GetPosition(a_obj_to);
+    RE::NiMatrix3 rotation;
+    rotation.SetEulerAnglesXYZ(a_obj_to->GetAngle());
+    // into the frame of the box, clamp to it and back. also covers flat boxes and points inside
+    auto local = rotation.Transpose() * (a_point_from - center);
+    local.x = std::clamp(local.x, min.x, max.x);
+    local.y = std::clamp(local.y, min.y, max.y);
+    local.z = std::clamp(local.z, min.z, max.z);
+    return rotation * local + center;
 }
 
 bool WorldObject::AreClose(const RE::TESObjectREFR* a_obj1, const RE::TESObjectREFR* a_obj2, const float threshold)
@@ -1814,6 +1816,7 @@ Math::LinAlg::Geometry::Geometry(const RE::TESObjectREFR* obj)
         FetchVertices(o3d, triShape);
         //FetchIndexes(triShape);
     });
+    has_vertices = !positions.empty();
 
     if (positions.empty()) {
         auto from = obj->GetBoundMin();
@@ -1836,13 +1839,19 @@ Math::LinAlg::Geometry::Geometry(const RE::TESObjectREFR* obj)
 }
 
 std::pair<RE::NiPoint3, RE::NiPoint3> Math::LinAlg::Geometry::GetBoundingBox() const
+{
+    auto [min, max] = GetLocalBoundingBox();
+    const auto scale = obj->GetScale();
+    return std::pair(min * scale, max * scale);
+}
+
+std::pair<RE::NiPoint3, RE::NiPoint3> Math::LinAlg::Geometry::GetLocalBoundingBox() const
 {
     auto min = RE::NiPoint3{0, 0, 0};
     auto max = RE::NiPoint3{0, 0, 0};
 
     for (auto i = 0; i < positions.size(); i++) {
-        //const auto p1 = Rotate(positions[i] * scale, angle);
-        const auto p1 = positions[i] * obj->GetScale();
+        const auto& p1 = positions[i];
 
         if (p1.x < min.x) {
             min.x = p1.x;
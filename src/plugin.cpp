@@ -1,5 +1,7 @@
 #include "MCP.h"
 #include "Threading.h"
+#include "CellScan.h"
+#include "ContainerJournal.h"
 
 Manager* M = nullptr;
 OurEventSink* eventSink = nullptr;
@@ -40,7 +42,9 @@ void OnMessage(SKSE::MessagingInterface::Message* message) {
         eventSourceHolder->AddEventSink<RE::TESSleepStopEvent>(eventSink);
         eventSourceHolder->AddEventSink<RE::TESWaitStopEvent>(eventSink);
         eventSourceHolder->AddEventSink<RE::TESFormDeleteEvent>(eventSink);
+        eventSourceHolder->AddEventSink<RE::TESCellAttachDetachEvent>(eventSink);
         SKSE::GetCrosshairRefEventSource()->AddEventSink(eventSink);
+        RE::UI::GetSingleton()->AddEventSink<RE::MenuOpenCloseEvent>(eventSink);
         RE::PlayerCharacter::GetSingleton()->AsBGSActorCellEventSource()->AddEventSink(eventSink);
         logger::info("Event sinks added.");
         
@@ -85,6 +89,8 @@ void LoadCallback(SKSE::SerializationInterface* serializationInterface) {
     DISABLE_IF_UNINSTALLED
 
 	eventSink->block_eventsinks.store(true);
+    CellScan::GetSingleton()->Cancel();
+    ContainerJournal::GetSingleton()->Cancel();
     logger::info("Loading Data from skse co-save.");
 
 
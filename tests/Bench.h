@@ -0,0 +1,36 @@
+#pragma once
+
+// Timing helpers for the bench_* targets. --quick shrinks the sizes so ctest can run them.
+namespace Bench {
+    inline bool quick = false;
+
+    inline void ParseArgs(const int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::string_view(argv[i]) == "--quick") quick = true;
+        }
+    }
+
+    // keeps the optimizer from dropping a result
+    template <typename T>
+    void Keep(T&& a_value) {
+        static volatile std::uintptr_t sink;
+        sink = sink + static_cast<std::uintptr_t>(std::hash<std::decay_t<T>>{}(a_value));
+    }
+
+    // best of a_repeats runs of a_fn, in nanoseconds per call of a_fn
+    template <typename Fn>
+    double Time(const int a_repeats, Fn&& a_fn) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < a_repeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            a_fn();
+            const auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = std::min(best, ns);
+        }
+        return best;
+    }
+
+    inline void Row(const char* a_name, const size_t a_n, const double a_ns, const char* a_unit = "op") {
+        std::printf("%-40s n=%-8zu %12.1f ns/%s\n", a_name, a_n, a_ns, a_unit);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Bare bones checks: a failure is printed with its location and counted, main returns Check::Result().
+namespace Check {
+    inline int& Failures() {
+        static int n = 0;
+        return n;
+    }
+
+    inline bool Report(const bool a_ok, const char* a_expr, const char* a_file, const int a_line) {
+        if (!a_ok) {
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", a_file, a_line, a_expr);
+            ++Failures();
+        }
+        return a_ok;
+    }
+
+    inline int Result() {
+        if (Failures()) std::fprintf(stderr, "%d check(s) failed\n", Failures());
+        else std::printf("all checks passed\n");
+        return Failures() ? 1 : 0;
+    }
+}
+
+#define CHECK(expr) Check::Report(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
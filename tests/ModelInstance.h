@@ -0,0 +1,26 @@
+#pragma once
+#include "BasicStageInstance.h"
+
+// Types::FormEditorIDX without the editor id and crafting flag, the rules don't look at them
+struct ModelXtra {
+    FormID form_id = 0;
+    bool is_fake = false;
+    bool is_decayed = false;
+    bool is_transforming = false;
+
+    bool operator==(const ModelXtra& other) const { return form_id == other.form_id; }
+    [[nodiscard]] bool Identical(const ModelXtra& other) const {
+        return form_id == other.form_id && is_fake == other.is_fake && is_decayed == other.is_decayed &&
+               is_transforming == other.is_transforming;
+    }
+};
+
+// StageInstance without the game: the same BasicStageInstance, the clock public so that the tests can compare it
+struct ModelInstance : BasicStageInstance<ModelXtra> {
+    using Xtra = ModelXtra;
+    using BasicStageInstance::BasicStageInstance;
+    using BasicStageInstance::_elapsed;
+    using BasicStageInstance::_delay_start;
+    using BasicStageInstance::_delay_mag;
+    using BasicStageInstance::_delay_formid;
+};
@@ -0,0 +1,336 @@
+#pragma once
+#include "CatchUp.h"
+#include "Evolution.h"
+#include "ModelInstance.h"
+
+// Manager and Source around one inventory without the game. The update, clean up and modulation rules are the ones
+// in Evolution.h and the step is StepInventory, like in the plugin. What is left here is the data and what stands in
+// for the game: an inventory is a count per form, the sources are fixed and registering a form only looks them up.
+// test_catch_up compares the old loop and CatchUp on it, test_time_jump the old loop and TimeJump.
+namespace ModelWorld {
+    using Slot = size_t;
+    using StageNo = unsigned int;
+    using Inventory = std::map<FormID, Count>;
+    using Inputs = Evolution::ModulationInputs;
+
+    struct Stage {
+        FormID formid = 0;
+        float duration = 0.1f;
+        bool fake = false;
+    };
+
+    struct StageUpdate {
+        const Stage* oldstage;
+        const Stage* newstage;
+        Count count;
+        float update_time;
+        bool new_is_fake;
+    };
+
+    // the part of DefaultSettings the rules read
+    struct Settings {
+        std::map<FormID, float> delayers;
+        std::vector<FormID> delayers_order;
+        std::map<FormID, std::tuple<FormID, float, std::vector<StageNo>>> transformers;  // result, duration, allowed
+        std::vector<FormID> transformers_order;
+        FormID decayed_id = 0;
+    };
+
+    struct Source {
+        using Instance = ModelInstance;
+
+        std::vector<Stage> stages;
+        Settings settings;
+        bool freeze = false;  // ShouldFreezeEvolution for the containers of the world
+
+        // from the above, in Finish
+        StageMath::Table stage_table;
+        Stage decayed_stage;
+        std::map<FormID, Stage> transformed_stages;
+
+        std::map<RefID, std::vector<ModelInstance>> data;
+        std::set<RefID> dirty_locs;
+        Evolution::CleanUpSchedule cleanup_schedule;
+        float last_cleanup = -1.f;
+        std::ptrdiff_t n_instances = 0;
+
+        void Finish() {
+            std::vector<float> durations;
+            for (const auto& stage : stages) durations.push_back(stage.duration);
+            stage_table = StageMath::Build(std::move(durations));
+            decayed_stage = {settings.decayed_id};
+            for (const auto& [formid, transformer] : settings.transformers) transformed_stages[formid] = {std::get<0>(transformer)};
+        }
+
+        [[nodiscard]] bool IsStageNo(const StageNo no) const { return no < stages.size(); }
+
+        [[nodiscard]] bool IsFakeStage(const StageNo no) const { return IsStageNo(no) && stages[no].fake; }
+
+        [[nodiscard]] const Stage& GetStage(const StageNo no) const { return stages[no]; }
+
+        void SetStageXtra(ModelInstance::Xtra& xtra, const StageNo no) const {
+            xtra.form_id = stages[no].formid;
+            xtra.is_fake = IsFakeStage(no);
+        }
+
+        void SetDecayedXtra(ModelInstance::Xtra& xtra) const {
+            xtra.form_id = decayed_stage.formid;
+            xtra.is_fake = false;
+        }
+
+        [[nodiscard]] bool IsDecayedItem(const FormID formid) const {
+            if (decayed_stage.formid == formid) return true;
+            return std::ranges::any_of(settings.transformers | std::views::values, [&](const auto& tr) { return std::get<0>(tr) == formid; });
+        }
+
+        void MarkDirty(const RefID loc) { dirty_locs.insert(loc); }
+
+        void ChangeNInstances(const std::ptrdiff_t delta) { n_instances += delta; }
+
+        auto EraseLocation(const std::map<RefID, std::vector<ModelInstance>>::iterator it) {
+            cleanup_schedule.Remove(it->first);
+            return data.erase(it);
+        }
+
+        float GetNextUpdateTime(const ModelInstance& inst) { return Evolution::Rules::GetNextUpdateTime(*this, inst); }
+
+        bool SetDelayOfInstance(ModelInstance& inst, const float t, const Inputs& inputs) const {
+            return Evolution::Rules::SetDelayOfInstance(*this, inst, t, inputs);
+        }
+    };
+
+    struct World {
+        std::vector<Source> sources;
+        std::map<RefID, Inventory> inventories;
+        float curr_time = 0.f;
+        float forgetting_time = 24.f;
+
+        // sorted, like Manager::GetSourcesAt
+        [[nodiscard]] std::vector<Slot> GetSourcesAt(const RefID loc) const {
+            std::vector<Slot> result;
+            for (Slot i = 0; i < sources.size(); ++i) {
+                if (sources[i].data.contains(loc)) result.push_back(i);
+            }
+            return result;
+        }
+
+        // Source::GetModulationInputs: the first of the modulators of the source that is in the inventory
+        [[nodiscard]] Inputs GetModulationInputs(const Slot i, const RefID loc) {
+            const auto& src = sources[i];
+            if (src.freeze) return {.freeze = true};
+            const auto& inventory = inventories[loc];
+            const auto first_in = [&inventory](const std::vector<FormID>& order) -> FormID {
+                for (const auto formid : order) {
+                    if (const auto it = inventory.find(formid); it != inventory.end() && it->second > 0) return formid;
+                }
+                return 0;
+            };
+            Inputs inputs;
+            inputs.transformer = first_in(src.settings.transformers_order);
+            inputs.delayer = first_in(src.settings.delayers_order);
+            if (const auto it = src.settings.transformers.find(inputs.transformer); inputs.transformer && it != src.settings.transformers.end()) {
+                inputs.allowed_stages = &std::get<2>(it->second);
+            }
+            return inputs;
+        }
+
+        bool CleanUp(const Slot i, const RefID a_deferred = 0) {
+            return Evolution::Rules::CleanUpData(sources[i], curr_time, forgetting_time, a_deferred);
+        }
+
+        void ApplyEvolutionInInventory(const RefID loc, const Count count, const FormID old_item, const FormID new_item) {
+            if (!old_item || !new_item || !count || old_item == new_item) return;
+            auto& inventory = inventories[loc];
+            if ((inventory[old_item] -= count) <= 0) inventory.erase(old_item);
+            inventory[new_item] += count;
+        }
+
+        // true if a source has formid as a stage
+        bool Register(const FormID formid, const Count count, const RefID loc, const float t) {
+            if (count <= 0) return false;
+            for (Slot i = 0; i < sources.size(); ++i) {
+                auto& src = sources[i];
+                const auto it = std::ranges::find(src.stages, formid, &Stage::formid);
+                if (it == src.stages.end()) continue;
+                const auto no = static_cast<StageNo>(it - src.stages.begin());
+                auto& inst = src.data[loc].emplace_back(t, no, count);
+                src.SetStageXtra(inst.xtra, no);
+                src.ChangeNInstances(1);
+                src.MarkDirty(loc);
+                src.SetDelayOfInstance(inst, t, GetModulationInputs(i, loc));
+                return true;
+            }
+            return false;
+        }
+
+        void ApplyStageUpdates(const Slot i, const RefID loc, const std::vector<StageUpdate>& updates, const float t) {
+            for (const auto& update : updates) {
+                ApplyEvolutionInInventory(loc, update.count, update.oldstage->formid, update.newstage->formid);
+                if (sources[i].IsDecayedItem(update.newstage->formid)) Register(update.newstage->formid, update.count, loc, t);
+            }
+        }
+
+        // Manager::UpdateInventory(ref, t)
+        bool UpdateInventory(RefID loc, float t);
+
+        [[nodiscard]] bool Identical(const World& other) const {
+            if (sources.size() != other.sources.size() || inventories != other.inventories) return false;
+            for (size_t i = 0; i < sources.size(); ++i) {
+                const auto& a = sources[i];
+                const auto& b = other.sources[i];
+                if (a.dirty_locs != b.dirty_locs || a.n_instances != b.n_instances || !(a.cleanup_schedule == b.cleanup_schedule) ||
+                    std::bit_cast<uint32_t>(a.last_cleanup) != std::bit_cast<uint32_t>(b.last_cleanup)) return false;
+                if (a.data.size() != b.data.size()) return false;
+                for (const auto& [loc, instances] : a.data) {
+                    const auto it = b.data.find(loc);
+                    if (it == b.data.end() || it->second.size() != instances.size()) return false;
+                    for (size_t k = 0; k < instances.size(); ++k) {
+                        if (!instances[k].Identical(it->second[k])) return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    // Manager::InventoryCatchUp on the world
+    struct CatchUpModel {
+        using Instance = ModelInstance;
+        using Slot = ModelWorld::Slot;
+        using Inputs = ModelWorld::Inputs;
+
+        World& world;
+        RefID loc;
+        std::vector<StageUpdate> updates;
+
+        [[nodiscard]] std::vector<Slot> SourcesAt() const { return world.GetSourcesAt(loc); }
+
+        [[nodiscard]] std::vector<ModelInstance>* Instances(const Slot i) const {
+            const auto it = world.sources[i].data.find(loc);
+            return it != world.sources[i].data.end() ? &it->second : nullptr;
+        }
+
+        [[nodiscard]] float NextUpdateTime(const Slot i, const ModelInstance& inst) const {
+            return world.sources[i].GetNextUpdateTime(inst);
+        }
+
+        bool UpdateStage(const Slot i, ModelInstance& inst, const float t) {
+            return Evolution::Rules::UpdateInstance(world.sources[i], loc, inst, t, updates);
+        }
+
+        [[nodiscard]] bool WouldChange(const Slot i, const ModelInstance& inst, const float t) const {
+            return Evolution::Rules::WouldChange(world.sources[i], inst, t);
+        }
+
+        void CleanUp(const Slot i) const { world.CleanUp(i); }
+
+        bool CleanUpOthers(const Slot i) const { return world.CleanUp(i, loc); }
+
+        [[nodiscard]] bool ShouldErase(const Slot i, const ModelInstance& inst) const {
+            return Evolution::Rules::ShouldErase(world.sources[i], inst, world.curr_time, world.forgetting_time);
+        }
+
+        void Erased(const Slot i, const std::ptrdiff_t n) const {
+            Evolution::Rules::FinishCleanUp(world.sources[i], loc, n, world.curr_time, world.forgetting_time);
+        }
+
+        void ApplyUpdates(const Slot i, const float t) {
+            world.ApplyStageUpdates(i, loc, updates, t);
+            updates.clear();
+        }
+
+        [[nodiscard]] Inputs GetInputs(const Slot i) const { return world.GetModulationInputs(i, loc); }
+
+        bool Modulate(const Slot i, ModelInstance& inst, const Inputs& inputs, const float t) const {
+            return world.sources[i].SetDelayOfInstance(inst, t, inputs);
+        }
+
+        void MarkDirty(const Slot i) const { world.sources[i].MarkDirty(loc); }
+
+        static bool Identical(const ModelInstance& a, const ModelInstance& b) { return a.Identical(b); }
+    };
+
+    inline bool World::UpdateInventory(const RefID loc, const float t) {
+        CatchUpModel model{*this, loc, {}};
+        return StepInventory(model, t);
+    }
+
+    // Manager::TimeJumpModel on the world
+    struct TimeJumpModel {
+        using Instance = ModelInstance;
+        using Slot = ModelWorld::Slot;
+        using Update = StageUpdate;
+
+        World& world;
+        std::vector<RefID> caught_up;
+
+        [[nodiscard]] std::vector<Slot> Sources() const {
+            std::vector<Slot> result(world.sources.size());
+            std::iota(result.begin(), result.end(), Slot{0});
+            return result;
+        }
+
+        [[nodiscard]] std::vector<Slot> SourcesAt(const RefID loc) const { return world.GetSourcesAt(loc); }
+
+        [[nodiscard]] std::vector<ModelInstance>* Instances(const Slot i, const RefID loc) const {
+            const auto it = world.sources[i].data.find(loc);
+            return it != world.sources[i].data.end() ? &it->second : nullptr;
+        }
+
+        void NextUpdateTimes(const Slot i, const std::vector<RefID>& locs, std::vector<float>& out) const {
+            Evolution::Rules::GetNextUpdateTimes(world.sources[i], locs, out);
+        }
+
+        bool UpdateStage(const Slot i, const RefID loc, ModelInstance& inst, const float t, std::vector<StageUpdate>& out) const {
+            return Evolution::Rules::UpdateInstance(world.sources[i], loc, inst, t, out);
+        }
+
+        bool Apply(const RefID loc, const std::vector<std::pair<Slot, StageUpdate>>& netted,
+                   const std::vector<std::pair<Slot, StageUpdate>>& updates) const {
+            for (const auto& [i, update] : netted) {
+                world.ApplyEvolutionInInventory(loc, update.count, update.oldstage->formid, update.newstage->formid);
+            }
+            bool registered = false;
+            for (const auto& [i, update] : updates) {
+                if (!world.sources[i].IsDecayedItem(update.newstage->formid)) continue;
+                registered |= world.Register(update.newstage->formid, update.count, loc, update.update_time);
+            }
+            return registered;
+        }
+
+        void CleanUp(const Slot i) const { world.CleanUp(i); }
+
+        void CatchUp(const RefID loc) {
+            caught_up.push_back(loc);
+            CatchUpModel model{world, loc, {}};
+            ::CatchUp(model, world.curr_time).Run();
+            StepInventory(model, world.curr_time);
+        }
+
+        [[nodiscard]] std::vector<FormID> Produces(const Slot i) const {
+            const auto& src = world.sources[i];
+            std::vector<FormID> result{src.decayed_stage.formid};
+            for (const auto& stage : src.stages) result.push_back(stage.formid);
+            for (const auto& stage : src.transformed_stages | std::views::values) result.push_back(stage.formid);
+            return result;
+        }
+
+        [[nodiscard]] std::vector<FormID> Modulators(const Slot i) const {
+            const auto& settings = world.sources[i].settings;
+            auto result = settings.delayers_order;
+            result.insert(result.end(), settings.transformers_order.begin(), settings.transformers_order.end());
+            return result;
+        }
+
+        [[nodiscard]] std::optional<Slot> SourceOf(const FormID formid) const {
+            for (Slot i = 0; i < world.sources.size(); ++i) {
+                if (std::ranges::find(world.sources[i].stages, formid, &Stage::formid) != world.sources[i].stages.end()) return i;
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] bool HasTransformer(const Slot i, const RefID loc) const {
+            return world.GetModulationInputs(i, loc).transformer != 0;
+        }
+    };
+}
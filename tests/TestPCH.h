@@ -0,0 +1,50 @@
+#pragma once
+
+// Stands in for PCH.h: the standard library and the aliases the game independent headers expect.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+constexpr float EPSILON = 1e-10f;
+
+using namespace std::literals;
+
+constexpr uint32_t player_refid = 20;
+
+using FormID = std::uint32_t;
+using RefID = std::uint32_t;
+using Count = std::int32_t;
+
+// the shared rules log like the plugin does, nothing here looks at it
+namespace logger {
+    template <typename... Args> void trace(Args&&...) {}
+    template <typename... Args> void debug(Args&&...) {}
+    template <typename... Args> void info(Args&&...) {}
+    template <typename... Args> void warn(Args&&...) {}
+    template <typename... Args> void error(Args&&...) {}
+    template <typename... Args> void critical(Args&&...) {}
+}
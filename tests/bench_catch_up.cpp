@@ -0,0 +1,91 @@
+#include "Bench.h"
+#include "CatchUp.h"
+#include "ModelWorld.h"
+
+// A container left alone for two days, then opened: the catch-up of Manager::UpdateInventory(ref) over every update
+// time in between. The old loop updates, cleans up and modulates every instance at every step, CatchUp only the ones
+// that change at it. Instances of four sources with six stages each, picked up over a day, a delayer in the container.
+namespace {
+    using namespace ModelWorld;
+
+    constexpr RefID loc = 0x100;
+
+    void OldCatchUp(World& world) {
+        while (true) {
+            std::set<float> times;
+            for (const auto i : world.GetSourcesAt(loc)) {
+                for (const auto& inst : world.sources[i].data.at(loc)) {
+                    if (const auto h = world.sources[i].GetNextUpdateTime(inst); h > 0) times.insert(h);
+                }
+            }
+            if (times.empty()) break;
+            const auto t = *times.begin() + 0.000028f;
+            if (t >= world.curr_time || !world.UpdateInventory(loc, t)) break;
+        }
+        world.UpdateInventory(loc, world.curr_time);
+    }
+
+    size_t NewCatchUp(World& world) {
+        CatchUpModel model{world, loc, {}};
+        CatchUp catch_up(model, world.curr_time);
+        catch_up.Run();
+        world.UpdateInventory(loc, world.curr_time);
+        return catch_up.GetStats().steps;
+    }
+
+    World MakeWorld(const size_t n) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> start(0.f, 24.f);
+        std::uniform_real_distribution<float> duration(2.f, 10.f);
+        World world;
+        world.curr_time = 72.f;
+        world.sources.resize(4);
+        for (size_t i = 0; i < world.sources.size(); ++i) {
+            auto& src = world.sources[i];
+            for (size_t k = 0; k < 6; ++k) src.stages.push_back({static_cast<FormID>(0x1000 * (i + 1) + k), duration(rng)});
+            src.settings.decayed_id = static_cast<FormID>(0x9000 + i);
+            src.settings.delayers[0xA001] = 0.5f;
+            src.settings.delayers_order.push_back(0xA001);
+            src.Finish();
+        }
+        auto& inventory = world.inventories[loc];
+        inventory[0xA001] = 1;
+        for (size_t j = 0; j < n; ++j) {
+            auto& src = world.sources[j % world.sources.size()];
+            auto& inst = src.data[loc].emplace_back(start(rng), 0u, 1);
+            inst.xtra.form_id = src.stages[0].formid;
+            inst.SetDelay(inst.start_time, 0.5f, 0xA001);
+            ++src.n_instances;
+            ++inventory[inst.xtra.form_id];
+        }
+        return world;
+    }
+
+    // best of a_repeats, the copy of the world not counted
+    template <typename Fn>
+    double TimeOn(const World& a_world, const int a_repeats, Fn&& a_fn) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < a_repeats; ++r) {
+            auto world = a_world;
+            best = std::min(best, Bench::Time(1, [&] { a_fn(world); }));
+        }
+        return best;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{10, 100} : std::vector<size_t>{10, 20, 40, 100, 1000, 5000};
+
+    for (const auto n : sizes) {
+        const auto world = MakeWorld(n);
+        const int repeats = n >= 1000 ? 2 : 20;
+        size_t steps = 0;
+        const auto old_ns = TimeOn(world, repeats, [](World& w) { OldCatchUp(w); });
+        const auto new_ns = TimeOn(world, repeats, [&steps](World& w) { steps = NewCatchUp(w); });
+        std::printf("%zu instances, %zu steps\n", n, steps);
+        Bench::Row("inventory catch-up, old loop", n, old_ns, "catch-up");
+        Bench::Row("inventory catch-up, CatchUp", n, new_ns, "catch-up");
+    }
+    return 0;
+}
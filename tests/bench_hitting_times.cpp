@@ -0,0 +1,35 @@
+#include "Bench.h"
+#include "HittingTimes.h"
+
+// HittingTimes::Evaluate per SIMD level for 1k, 10k and 200k rows. Levels the CPU lacks fall back to the best it has.
+int main(const int argc, char** argv) {
+    using HittingTimes::SimdLevel;
+    Bench::ParseArgs(argc, argv);
+    std::printf("detected: %s\n", HittingTimes::GetSimdLevelName());
+
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{1000} : std::vector<size_t>{1000, 10000, 200000};
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> time(0.f, 20000.f);
+    std::uniform_real_distribution<float> mag(0.f, 2.f);
+
+    for (const auto n : sizes) {
+        std::vector<float> delay_start(n), elapsed(n), delay_mag(n), schranke(n), out(n);
+        for (size_t i = 0; i < n; ++i) {
+            delay_start[i] = time(rng);
+            elapsed[i] = time(rng) / 100.f;
+            delay_mag[i] = mag(rng);
+            schranke[i] = 24.f;
+        }
+        const int reps = Bench::quick ? 2 : std::max(5, static_cast<int>(2000000 / n));
+        for (const auto level : {SimdLevel::kScalar, SimdLevel::kSSE, SimdLevel::kAVX}) {
+            const auto ns = Bench::Time(reps, [&] {
+                HittingTimes::Evaluate(level, delay_start.data(), elapsed.data(), delay_mag.data(), schranke.data(),
+                                       out.data(), n);
+                Bench::Keep(out[n / 2]);
+            });
+            const auto name = std::string("Evaluate ") + HittingTimes::GetSimdLevelName(level);
+            Bench::Row(name.c_str(), n, ns / static_cast<double>(n), "row");
+        }
+    }
+    return 0;
+}
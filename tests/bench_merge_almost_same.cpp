@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "InstanceOps.h"
+#include "ModelInstance.h"
+
+// The merge step of CleanUpLocation for one container. The pairwise loop compares every pair, the sorted window
+// only neighbours in (stage, form, start time). Instances are picked up over a day, a few stages and forms, so
+// there is the odd merge but most pairs are far apart.
+namespace {
+    void PairwiseMerge(std::vector<ModelInstance>& instances, const float curr_time) {
+        for (auto it = instances.begin(); it + 1 != instances.end(); ++it) {
+            for (auto it2 = it + 1; it2 != instances.end(); ++it2) {
+                if (it2->count <= 0) continue;
+                if (it->AlmostSameExceptCount(*it2, curr_time)) {
+                    it->count += it2->count;
+                    it2->count = 0;
+                }
+            }
+        }
+    }
+
+    std::vector<ModelInstance> MakeLocation(const size_t n) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> start(0.f, 24.f);
+        std::uniform_int_distribution<int> small(0, 3);
+        std::vector<ModelInstance> instances;
+        for (size_t i = 0; i < n; ++i) {
+            auto& inst = instances.emplace_back(100.f + start(rng), static_cast<unsigned int>(small(rng)), 1);
+            inst.xtra.form_id = 0x100 + small(rng);
+        }
+        return instances;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{10, 100} : std::vector<size_t>{10, 20, 40, 100, 1000, 5000};
+
+    for (const auto n : sizes) {
+        const auto instances = MakeLocation(n);
+        const int repeats = n >= 1000 ? 3 : 200;
+        auto pairwise = instances;
+        auto window = instances;
+        const auto old_ns = Bench::Time(repeats, [&] {
+            PairwiseMerge(pairwise, 130.f);
+            Bench::Keep(pairwise.front().count);
+        });
+        const auto new_ns = Bench::Time(repeats, [&] {
+            InstanceOps::MergeAlmostSame(window, 130.f);
+            Bench::Keep(window.front().count);
+        });
+        Bench::Row("MergeAlmostSame, pairwise", n, old_ns, "location");
+        Bench::Row("MergeAlmostSame, sorted window", n, new_ns, "location");
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "InstanceOps.h"
+#include "ModelInstance.h"
+
+// Source::MoveInstances for one form out of a container: all but one of its items, so every instance of the form
+// moves whole and the last one is split. The old loop sorted indices with a map lookup per comparison, shifted every
+// index past the ones already gone and moved each instance with a find and a mid-vector erase. Instances of the form
+// are interleaved with as many of another form.
+namespace {
+    using Location = std::vector<ModelInstance>;
+
+    // StageInstance::operator==, MoveInstance found the instance to erase with it
+    bool Equal(const ModelInstance& a, const ModelInstance& b) {
+        return a.no == b.no && a.count == b.count && std::fabs(a.start_time - b.start_time) < EPSILON &&
+               std::fabs(a._elapsed - b._elapsed) < EPSILON && a.xtra == b.xtra;
+    }
+
+    Count OldMove(std::map<RefID, Location>& data, const RefID from, const RefID to, const FormID form, Count count,
+                  const float curr_time) {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < data.at(from).size(); ++i) {
+            if (data.at(from)[i].xtra.form_id == form) candidates.push_back(i);
+        }
+        std::ranges::sort(candidates, [&](const size_t a, const size_t b) {
+            return data[from][a].GetElapsed(curr_time) > data[from][b].GetElapsed(curr_time);
+        });
+        std::vector<size_t> removed;
+        for (const auto index : candidates) {
+            if (!count) break;
+            size_t shift = 0;
+            for (const auto r : removed) shift += index > r;
+            auto* instance = &data[from][index - shift];
+            if (count <= instance->count) {
+                instance->count -= count;
+                ModelInstance split(*instance);
+                split.count = count;
+                data[to].push_back(split);
+                count = 0;
+            } else {
+                count -= instance->count;
+                auto& from_instances = data.at(from);
+                const ModelInstance moved(*instance);
+                const auto it = std::ranges::find_if(from_instances, [&](const ModelInstance& x) { return Equal(x, moved); });
+                from_instances.erase(it);
+                data[to].push_back(moved);
+                removed.push_back(index);
+            }
+        }
+        return count;
+    }
+
+    Count NewMove(std::map<RefID, Location>& data, const RefID from, const RefID to, const FormID form, Count count,
+                  const float curr_time) {
+        const auto taken = InstanceOps::Take(data.at(from), form, count, true, curr_time, [&](size_t) { return &data[to]; });
+        count = taken.count;
+        if (taken.split) {
+            ModelInstance split(*taken.split);
+            split.count = count;
+            data[to].push_back(split);
+            count = 0;
+        }
+        return count;
+    }
+
+    constexpr RefID from = 0x100;
+    constexpr RefID to = 0x200;
+    constexpr FormID form = 0x1001;
+
+    std::map<RefID, Location> MakeData(const size_t n, Count& total) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> start(0.f, 24.f);
+        std::uniform_int_distribution<int> count(1, 3);
+        std::map<RefID, Location> data;
+        total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            for (const FormID f : {form, FormID{0x1002}}) {
+                auto& inst = data[from].emplace_back(100.f + start(rng), 0u, count(rng));
+                inst.xtra.form_id = f;
+                if (f == form) total += inst.count;
+            }
+        }
+        data[to];
+        return data;
+    }
+
+    // best of a_repeats, the copy of the data not counted
+    template <typename Fn>
+    double TimeOn(const std::map<RefID, Location>& a_data, const int a_repeats, Fn&& a_fn) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < a_repeats; ++r) {
+            auto data = a_data;
+            best = std::min(best, Bench::Time(1, [&] { Bench::Keep(a_fn(data)); }));
+        }
+        return best;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{1, 10, 100} : std::vector<size_t>{1, 10, 100, 1000};
+
+    for (const auto n : sizes) {
+        Count total = 0;
+        const auto data = MakeData(n, total);
+        const int repeats = n >= 1000 ? 10 : 200;
+        const auto old_ns = TimeOn(data, repeats, [&](auto& d) { return OldMove(d, from, to, form, total - 1, 130.f); });
+        const auto new_ns = TimeOn(data, repeats, [&](auto& d) { return NewMove(d, from, to, form, total - 1, 130.f); });
+        Bench::Row("MoveInstances, old loop", n, old_ns, "move");
+        Bench::Row("MoveInstances, InstanceOps::Take", n, new_ns, "move");
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Bench.h"
+#include "SlotMap.h"
+
+// The source storage cost of one UpdateWO call. The old code did sources.reserve(size + 1) and sources.shrink_to_fit()
+// around the loop, which reallocates a full vector and moves every Source twice per call. The slot map has nothing to do.
+// The model source has about as many containers as Source and its DefaultSettings, with a little data in each.
+namespace {
+    struct ModelSource {
+        FormID formid = 0;
+        std::string editorid = "source";
+        std::map<unsigned int, std::string> stages;
+        std::unordered_map<FormID, unsigned int> stage_formids;
+        std::set<unsigned int> fake_stages;
+        std::map<RefID, std::vector<std::array<float, 8>>> data;
+        std::set<RefID> dirty_locs;
+        std::vector<double> stage_prefix;
+        std::array<std::map<FormID, float>, 6> settings_maps;
+        std::array<std::vector<FormID>, 4> settings_orders;
+        std::array<std::string, 3> names{"a", "b", "c"};
+
+        explicit ModelSource(const FormID a_formid) : formid(a_formid) {
+            for (unsigned int i = 0; i < 4; ++i) {
+                stages[i] = "stage";
+                stage_formids[a_formid * 8 + i] = i;
+                stage_prefix.push_back(i);
+            }
+            data[a_formid].resize(3);
+            for (auto& m : settings_maps) m[a_formid] = 1.f;
+            for (auto& v : settings_orders) v.push_back(a_formid);
+        }
+    };
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{50} : std::vector<size_t>{50, 500, 2000};
+    const int n_calls = Bench::quick ? 20 : 500;
+
+    for (const auto n : sizes) {
+        std::vector<ModelSource> vec;
+        SlotMap<ModelSource> slots;
+        for (size_t i = 0; i < n; ++i) {
+            vec.emplace_back(static_cast<FormID>(i + 1));
+            slots.emplace_back(static_cast<FormID>(i + 1));
+        }
+        vec.shrink_to_fit();
+
+        const auto old_ns = Bench::Time(3, [&] {
+            for (int c = 0; c < n_calls; ++c) {
+                vec.reserve(vec.size() + 1);
+                Bench::Keep(vec[c % n].formid);
+                vec.shrink_to_fit();
+            }
+        }) / n_calls;
+        const auto new_ns = Bench::Time(3, [&] {
+            for (int c = 0; c < n_calls; ++c) Bench::Keep(slots[c % n].formid);
+        }) / n_calls;
+        Bench::Row("UpdateWO storage, vector reserve+shrink", n, old_ns, "call");
+        Bench::Row("UpdateWO storage, slot map", n, new_ns, "call");
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Bench.h"
+#include "Snapshot.h"
+
+// Manager::RefIsRegistered from the event threads while updates run: before, a reader took sourceMutex_ shared and
+// looked at the location index, so it waited out every update that held the mutex. Now it loads the published
+// Snapshot and never waits. One writer alternates an update (busy for a while, the lock held in the old scheme) and
+// a pause, the readers look up random locations in batches and note the slowest batch. The update sleeps instead
+// of spinning: it stands for work on another core, so that the numbers mean the same with few cores. For the same
+// reason the writer publishes versions built beforehand, building one is timed on its own.
+namespace {
+    struct Lookup {
+        std::unordered_set<RefID> locations;
+    };
+
+    constexpr size_t n_locations = 10000;
+    constexpr size_t batch = 64;
+
+    struct Result {
+        double ns_per_lookup = 0;
+        double worst_batch_us = 0;
+    };
+
+    // a_read(loc) -> bool, a_write() is one update
+    template <typename Read, typename Write>
+    Result Run(const size_t a_readers, const std::chrono::milliseconds a_for, Read&& a_read, Write&& a_write) {
+        std::atomic<bool> stop = false;
+        std::atomic<size_t> lookups = 0;
+        std::atomic<int64_t> worst_ns = 0;
+        std::vector<std::thread> readers;
+        for (size_t r = 0; r < a_readers; ++r) {
+            readers.emplace_back([&, r] {
+                std::mt19937 rng(static_cast<uint32_t>(r + 1));
+                std::uniform_int_distribution<RefID> loc(1, 2 * n_locations);
+                size_t n = 0;
+                size_t found = 0;
+                int64_t worst = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    const auto start = std::chrono::steady_clock::now();
+                    for (size_t k = 0; k < batch; ++k) found += a_read(loc(rng));
+                    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                    worst = std::max(worst, static_cast<int64_t>(ns));
+                    n += batch;
+                }
+                Bench::Keep(found);
+                lookups += n;
+                for (auto w = worst_ns.load(); w < worst && !worst_ns.compare_exchange_weak(w, worst);) {
+                }
+            });
+        }
+        std::thread writer([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                a_write();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+        const auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(a_for);
+        stop = true;
+        for (auto& t : readers) t.join();
+        writer.join();
+        const auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return {ns * static_cast<double>(a_readers) / static_cast<double>(std::max<size_t>(lookups.load(), 1)),
+                static_cast<double>(worst_ns.load()) / 1000.};
+    }
+
+    std::unordered_set<RefID> Locations() {
+        std::unordered_set<RefID> result;
+        for (RefID loc = 1; loc <= 2 * n_locations; loc += 2) result.insert(loc);
+        return result;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const auto duration = Bench::quick ? std::chrono::milliseconds(50) : std::chrono::milliseconds(500);
+    const auto update = std::chrono::microseconds(500);
+    std::printf("%u hardware threads, updates of %lld us\n", std::thread::hardware_concurrency(),
+                static_cast<long long>(update.count()));
+
+    for (const size_t n_readers : Bench::quick ? std::vector<size_t>{2} : std::vector<size_t>{1, 2, 4}) {
+        std::shared_mutex mutex;
+        auto index = Locations();
+        const auto locked = Run(
+            n_readers, duration,
+            [&](const RefID loc) {
+                std::shared_lock lock(mutex);
+                return index.contains(loc);
+            },
+            [&] {
+                std::unique_lock lock(mutex);
+                std::this_thread::sleep_for(update);
+                index.erase(1);
+                index.insert(1);
+            });
+
+        Snapshot<Lookup> lookup;
+        const std::array versions{std::make_shared<const Lookup>(Lookup{Locations()}), std::make_shared<const Lookup>(Lookup{Locations()})};
+        size_t n_written = 0;
+        const auto snapshot = Run(
+            n_readers, duration, [&](const RefID loc) { return lookup.Load()->locations.contains(loc); },
+            [&] {
+                std::this_thread::sleep_for(update);
+                lookup.Publish(versions[++n_written % 2]);
+            });
+
+        std::printf("%zu readers: slowest batch of %zu lookups %.0f us with the mutex, %.0f us with the snapshot\n",
+                    n_readers, batch, locked.worst_batch_us, snapshot.worst_batch_us);
+        Bench::Row("lookup under sourceMutex_ shared", n_readers, locked.ns_per_lookup, "lookup");
+        Bench::Row("lookup in the Snapshot", n_readers, snapshot.ns_per_lookup, "lookup");
+    }
+
+    // what PublishLookup_ does after a batch of changes
+    const auto index = Locations();
+    Snapshot<Lookup> lookup;
+    const auto publish_ns = Bench::Time(Bench::quick ? 3 : 20, [&] {
+        auto next = std::make_shared<Lookup>();
+        next->locations.reserve(index.size());
+        for (const auto loc : index) next->locations.insert(loc);
+        lookup.Publish(std::move(next));
+    });
+    Bench::Row("build and publish a snapshot", n_locations, publish_ns, "publish");
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "Bench.h"
+
+// Manager::GetSource before and after the stage index: a linear walk over the sources, each walking its stages map
+// (the old Source::IsStage), against the stage -> slot hash lookup confirmed by the source's reverse map.
+// Sources are modelled by their stage maps only, with the Stage payload padded to roughly its size in the plugin.
+namespace {
+    using StageNo = unsigned int;
+
+    struct Stage {
+        FormID formid = 0;
+        float duration = 0.f;
+        std::string name;
+        std::array<char, 48> rest{};
+    };
+
+    struct ModelSource {
+        std::map<StageNo, Stage> stages;
+        std::unordered_map<FormID, StageNo> stage_formids;
+
+        bool IsStageScan(const FormID a_formid) const {
+            return std::ranges::any_of(stages | std::views::values, [&](const Stage& s) { return s.formid == a_formid; });
+        }
+        bool IsStage(const FormID a_formid) const { return stage_formids.contains(a_formid); }
+    };
+
+    constexpr StageNo n_stages = 4;
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{100} : std::vector<size_t>{100, 1000, 10000};
+    const size_t n_queries = Bench::quick ? 1000 : 20000;
+
+    for (const auto n_sources : sizes) {
+        std::vector<ModelSource> sources(n_sources);
+        std::unordered_map<FormID, size_t> stage_index;
+        FormID next_formid = 0x800;
+        for (size_t i = 0; i < n_sources; ++i) {
+            for (StageNo no = 0; no < n_stages; ++no) {
+                const auto formid = next_formid++;
+                sources[i].stages[no] = {formid, 1.f, "stage"};
+                sources[i].stage_formids[formid] = no;
+                stage_index.try_emplace(formid, i);
+            }
+        }
+
+        // half hits, half forms no source knows (most container events)
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<FormID> hit(0x800, next_formid - 1);
+        std::uniform_int_distribution<FormID> miss(next_formid, next_formid + 100000);
+        std::vector<FormID> queries(n_queries);
+        for (size_t q = 0; q < n_queries; ++q) queries[q] = q % 2 ? hit(rng) : miss(rng);
+
+        const auto scan = [&](const FormID a_formid) -> const ModelSource* {
+            for (const auto& src : sources) {
+                if (src.IsStageScan(a_formid)) return &src;
+            }
+            return nullptr;
+        };
+        const auto indexed = [&](const FormID a_formid) -> const ModelSource* {
+            const auto it = stage_index.find(a_formid);
+            if (it == stage_index.end() || it->second >= sources.size()) return nullptr;
+            if (const auto& src = sources[it->second]; src.IsStage(a_formid)) return &src;
+            return nullptr;
+        };
+
+        // same answers before timing anything
+        for (const auto formid : queries) {
+            if (scan(formid) != indexed(formid)) {
+                std::fprintf(stderr, "index and scan disagree on %u\n", formid);
+                return 1;
+            }
+        }
+
+        const auto run = [&](auto&& lookup) {
+            return Bench::Time(5, [&] {
+                size_t found = 0;
+                for (const auto formid : queries) found += lookup(formid) != nullptr;
+                Bench::Keep(found);
+            }) / static_cast<double>(n_queries);
+        };
+        Bench::Row("GetSource scan", n_sources, run(scan), "lookup");
+        Bench::Row("GetSource index", n_sources, run(indexed), "lookup");
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "Bench.h"
+#include "SpatialHashGrid.h"
+
+// The modulator search for one world object. The old SearchNearbyModulators scanned the references of the object's
+// cell, then went through the whole cellMap of the worldspace for the adjacent cells and scanned those. The grid only
+// holds the modulators and looks at the buckets around the object. 3x3 loaded exterior cells of 200 references each,
+// 20 of them modulators, in a worldspace of n cells. Positions are synthetic.
+namespace {
+    constexpr float cell_size = 4096.f;
+    constexpr float search_range = 1500.f;
+    constexpr FormID space = 0x3C;
+
+    struct Ref {
+        RefID refid;
+        FormID base;
+        float x, y, z;
+    };
+
+    struct Cell {
+        int32_t cx;
+        int32_t cy;
+        std::vector<Ref> refs;  // empty unless loaded
+    };
+
+    struct World {
+        std::vector<Cell> cell_map;  // the worldspace's cellMap, in no particular order
+        size_t loaded = 0;           // index of the cell the objects are in
+        std::vector<FormID> modulators;
+        SpatialHashGrid grid;
+    };
+
+    World MakeWorld(const size_t n_cells) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> in_cell(0.f, cell_size);
+        std::uniform_int_distribution<int> clutter(0x2000, 0x2400);
+        World world;
+        world.modulators = {0x10, 0x11, 0x12, 0x13};
+        const auto side = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<double>(std::max<size_t>(n_cells, 9)))));
+        for (int32_t cx = 0; cx < side && world.cell_map.size() < std::max<size_t>(n_cells, 9); ++cx) {
+            for (int32_t cy = 0; cy < side && world.cell_map.size() < std::max<size_t>(n_cells, 9); ++cy) {
+                world.cell_map.push_back({cx - side / 2, cy - side / 2, {}});
+            }
+        }
+        std::ranges::shuffle(world.cell_map, rng);
+        RefID next = 0xFF000000;
+        for (size_t i = 0; i < world.cell_map.size(); ++i) {
+            auto& cell = world.cell_map[i];
+            if (std::abs(cell.cx) > 1 || std::abs(cell.cy) > 1) continue;
+            if (cell.cx == 0 && cell.cy == 0) world.loaded = i;
+            // 2 modulators in each of the outer cells, 4 in the middle one
+            const int n_modulators = cell.cx == 0 && cell.cy == 0 ? 4 : 2;
+            for (int k = 0; k < 200; ++k) {
+                const bool modulator = k < n_modulators;
+                const FormID base = modulator ? world.modulators[static_cast<size_t>(k) % world.modulators.size()]
+                                              : static_cast<FormID>(clutter(rng));
+                const Ref ref{next++, base, cell.cx * cell_size + in_cell(rng), cell.cy * cell_size + in_cell(rng), 0.f};
+                cell.refs.push_back(ref);
+                if (modulator) world.grid.Insert({ref.refid, ref.base, space, ref.x, ref.y, ref.z, 0.f});
+            }
+        }
+        return world;
+    }
+
+    float Dist2(const Ref& r, const float x, const float y, const float z) {
+        return (r.x - x) * (r.x - x) + (r.y - y) * (r.y - y) + (r.z - z) * (r.z - z);
+    }
+
+    // SearchModulatorInCell: ForEachReferenceInRange, the first reference of a modulator form
+    FormID SearchCell(const Cell& cell, const std::set<FormID>& modulators, const float x, const float y, const float z) {
+        for (const auto& ref : cell.refs) {
+            if (Dist2(ref, x, y, z) <= search_range * search_range && modulators.contains(ref.base)) return ref.base;
+        }
+        return 0;
+    }
+
+    FormID OldSearch(const World& world, const std::vector<FormID>& candidates, const float x, const float y, const float z) {
+        const auto candidates_set = std::set(candidates.begin(), candidates.end());
+        const auto& cell = world.cell_map[world.loaded];
+        if (const auto found = SearchCell(cell, candidates_set, x, y, z)) return found;
+        for (const auto& other : world.cell_map) {
+            if (&other == &cell || std::abs(other.cx - cell.cx) > 1 || std::abs(other.cy - cell.cy) > 1) continue;
+            if (const auto found = SearchCell(other, candidates_set, x, y, z)) return found;
+        }
+        return 0;
+    }
+
+    FormID NewSearch(const World& world, const std::vector<FormID>& candidates, const float x, const float y, const float z) {
+        static thread_local std::vector<SpatialHashGrid::Entry> out;
+        world.grid.Query(space, x, y, z, search_range, candidates, out);
+        return out.empty() ? 0 : out.front().base;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<size_t> sizes = Bench::quick ? std::vector<size_t>{9, 100} : std::vector<size_t>{9, 100, 1000, 4000};
+
+    // objects spread over the loaded cell, one search each
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> in_cell(0.f, cell_size);
+    std::vector<std::array<float, 3>> objects(1000);
+    for (auto& o : objects) o = {in_cell(rng), in_cell(rng), 0.f};
+    // the delayers of one source: two of the four modulator forms
+    const std::vector<FormID> candidates{0x11, 0x13};
+
+    for (const auto n : sizes) {
+        const auto world = MakeWorld(n);
+        size_t found_old = 0;
+        size_t found_new = 0;
+        const auto old_ns = Bench::Time(5, [&] {
+            found_old = 0;
+            for (const auto& [x, y, z] : objects) found_old += OldSearch(world, candidates, x, y, z) != 0;
+        });
+        const auto new_ns = Bench::Time(5, [&] {
+            found_new = 0;
+            for (const auto& [x, y, z] : objects) found_new += NewSearch(world, candidates, x, y, z) != 0;
+        });
+        std::printf("%zu cells, %zu modulators in the grid, found for %zu/%zu of %zu objects\n", world.cell_map.size(),
+                    world.grid.size(), found_old, found_new, objects.size());
+        const auto per_object = static_cast<double>(objects.size());
+        Bench::Row("modulator search, cell scan", n, old_ns / per_object, "object");
+        Bench::Row("modulator search, SpatialHashGrid", n, new_ns / per_object, "object");
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "Bench.h"
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+
+// Finding the modulators in range of every tracked object in the loaded cells, e.g. after a wait. One grid query per
+// object, the way each object searched on its own, against one SweepAndPrune pass over both sets, each followed by the
+// exact test. 5000 objects and 200 modulators over 3x3 exterior cells, positions synthetic. The sizes are the ones of
+// the default settings: no search radius, proximity_range between the bounds, which are taken as spheres here.
+namespace {
+    constexpr float area = 3 * 4096.f;
+    constexpr float proximity_range = 40.f;  // Settings::proximity_range
+    constexpr float radius = 30.f;           // of every object and modulator
+    constexpr float position_slack = 64.f;   // ModulatorGrid::position_slack
+    constexpr float range = proximity_range + 2 * radius;
+    constexpr FormID space = 0x3C;
+
+    struct Point {
+        RefID refid;
+        FormID base;
+        float x, y, z;
+    };
+
+    std::vector<Point> Scatter(const size_t n, const RefID first, const std::vector<FormID>& bases, std::mt19937& rng) {
+        std::uniform_real_distribution<float> xy(0.f, area);
+        std::uniform_real_distribution<float> height(-200.f, 200.f);
+        std::vector<Point> out;
+        for (size_t i = 0; i < n; ++i) out.push_back({first + static_cast<RefID>(i), bases[i % bases.size()], xy(rng), xy(rng), height(rng)});
+        return out;
+    }
+
+    float Dist2(const Point& a, const Point& b) {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z);
+    }
+
+    // object index -> modulator refids in range
+    using Assignment = std::vector<std::vector<RefID>>;
+
+    void PerObject(const std::vector<Point>& objects, const SpatialHashGrid& grid, const std::vector<FormID>& bases, Assignment& out) {
+        std::vector<SpatialHashGrid::Entry> entries;
+        for (size_t i = 0; i < objects.size(); ++i) {
+            const auto& o = objects[i];
+            grid.Query(space, o.x, o.y, o.z, range + position_slack, bases, entries);
+            out[i].clear();
+            for (const auto& e : entries) {
+                if (Dist2(o, {e.refid, e.base, e.x, e.y, e.z}) <= range * range) out[i].push_back(e.refid);
+            }
+        }
+    }
+
+    void Batched(const std::vector<Point>& objects, const std::vector<Point>& modulators, Assignment& out) {
+        std::vector<SweepAndPrune::Box> object_boxes;
+        std::vector<SweepAndPrune::Box> modulator_boxes;
+        object_boxes.reserve(objects.size());
+        modulator_boxes.reserve(modulators.size());
+        // as in ModulatorGrid::BeginBatch
+        constexpr float half = proximity_range / 2.f + position_slack + radius;
+        for (const auto& o : objects) object_boxes.push_back(SweepAndPrune::Around(space, o.x, o.y, o.z, half));
+        for (const auto& m : modulators) modulator_boxes.push_back(SweepAndPrune::Around(space, m.x, m.y, m.z, half));
+        for (auto& found : out) found.clear();
+        SweepAndPrune::Pairs(object_boxes, modulator_boxes, [&](const size_t i, const size_t j) {
+            if (Dist2(objects[i], modulators[j]) <= range * range) out[i].push_back(modulators[j].refid);
+        });
+    }
+
+    void AllPairs(const std::vector<Point>& objects, const std::vector<Point>& modulators, Assignment& out) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            out[i].clear();
+            for (const auto& m : modulators) {
+                if (Dist2(objects[i], m) <= range * range) out[i].push_back(m.refid);
+            }
+        }
+    }
+
+    size_t Total(const Assignment& a) {
+        size_t n = 0;
+        for (const auto& found : a) n += found.size();
+        return n;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<std::pair<size_t, size_t>> sizes = Bench::quick ? std::vector<std::pair<size_t, size_t>>{{500, 20}}
+                                                                      : std::vector<std::pair<size_t, size_t>>{{500, 20}, {5000, 200}, {5000, 2000}};
+    const std::vector<FormID> bases{0x10, 0x11, 0x12, 0x13};
+
+    for (const auto& [n_objects, n_modulators] : sizes) {
+        std::mt19937 rng(42);
+        const auto objects = Scatter(n_objects, 0xFF000000, {0x2000}, rng);
+        const auto modulators = Scatter(n_modulators, 0xFF800000, bases, rng);
+        SpatialHashGrid grid;
+        for (const auto& m : modulators) grid.Insert({m.refid, m.base, space, m.x, m.y, m.z, radius});
+
+        Assignment per_object(n_objects), batched(n_objects), all_pairs(n_objects);
+        const int repeats = n_objects >= 5000 ? 5 : 20;
+        const auto grid_ns = Bench::Time(repeats, [&] { PerObject(objects, grid, bases, per_object); });
+        const auto sap_ns = Bench::Time(repeats, [&] { Batched(objects, modulators, batched); });
+        const auto all_ns = Bench::Time(repeats, [&] { AllPairs(objects, modulators, all_pairs); });
+        std::printf("%zu objects, %zu modulators: %zu/%zu/%zu in range\n", n_objects, n_modulators, Total(per_object),
+                    Total(batched), Total(all_pairs));
+        Bench::Row("modulators in range, grid per object", n_objects, grid_ns, "pass");
+        Bench::Row("modulators in range, SweepAndPrune", n_objects, sap_ns, "pass");
+        Bench::Row("modulators in range, every pair", n_objects, all_ns, "pass");
+    }
+    return 0;
+}
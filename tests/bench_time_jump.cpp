@@ -0,0 +1,95 @@
+#include "Bench.h"
+#include "ModelWorld.h"
+#include "TimeJump.h"
+
+// Waiting for 24 hours next to a thousand containers: every one of them is due. Manager::HandleTimeJump used to run
+// UpdateInventory(ref) on them one after the other, a CatchUp through every update time of each. TimeJump advances
+// them together, per source one batch of next update times and each due instance straight to the end. Four sources
+// with six stages, one decays into the first stage of the next, a delayer in every third container.
+namespace {
+    using namespace ModelWorld;
+
+    constexpr float t_before = 48.f;
+    constexpr float t_after = t_before + 24.f;
+
+    World MakeWorld(const size_t n_locs, const size_t n_per_loc) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> age(0.f, 24.f);
+        std::uniform_real_distribution<float> duration(2.f, 10.f);
+        std::uniform_int_distribution<Count> count(1, 3);
+        World world;
+        world.curr_time = t_after;
+        world.forgetting_time = 1000.f;
+        world.sources.resize(4);
+        for (size_t i = 0; i < world.sources.size(); ++i) {
+            auto& src = world.sources[i];
+            for (size_t k = 0; k < 6; ++k) src.stages.push_back({static_cast<FormID>(0x1000 * (i + 1) + k), duration(rng)});
+            src.settings.decayed_id = i == 0 ? 0x2000 : static_cast<FormID>(0x9000 + i);
+            src.settings.delayers[0xA001] = 0.5f;
+            src.settings.delayers_order.push_back(0xA001);
+            src.Finish();
+        }
+        for (size_t l = 0; l < n_locs; ++l) {
+            const auto loc = static_cast<RefID>(0x100 + l);
+            auto& inventory = world.inventories[loc];
+            if (l % 3 == 0) inventory[0xA001] = 1;
+            for (size_t j = 0; j < n_per_loc; ++j) {
+                auto& src = world.sources[j % world.sources.size()];
+                auto& inst = src.data[loc].emplace_back(t_before - age(rng), 0u, count(rng));
+                inst.xtra.form_id = src.stages[0].formid;
+                if (l % 3 == 0) inst.SetDelay(inst.start_time, 0.5f, 0xA001);
+                ++src.n_instances;
+                inventory[inst.xtra.form_id] += inst.count;
+            }
+        }
+        return world;
+    }
+
+    // HandleTimeJump before: the due locations one at a time
+    void OneByOne(World& world) {
+        for (const auto& loc : world.inventories | std::views::keys) {
+            CatchUpModel model{world, loc, {}};
+            CatchUp(model, world.curr_time).Run();
+            world.UpdateInventory(loc, world.curr_time);
+        }
+    }
+
+    TimeJump<TimeJumpModel>::Stats Together(World& world) {
+        std::vector<RefID> locs;
+        for (const auto& loc : world.inventories | std::views::keys) locs.push_back(loc);
+        TimeJumpModel model{world, {}};
+        TimeJump jump(model, world.curr_time);
+        jump.Run(locs);
+        return jump.GetStats();
+    }
+
+    template <typename Fn>
+    double TimeOn(const World& a_world, const int a_repeats, Fn&& a_fn) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int r = 0; r < a_repeats; ++r) {
+            auto world = a_world;
+            best = std::min(best, Bench::Time(1, [&] { a_fn(world); }));
+        }
+        return best;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Bench::ParseArgs(argc, argv);
+    const std::vector<std::pair<size_t, size_t>> sizes = Bench::quick ? std::vector<std::pair<size_t, size_t>>{{20, 100}}
+                                                                      : std::vector<std::pair<size_t, size_t>>{{100, 100}, {1000, 100}};
+
+    for (const auto& [n_locs, n_per_loc] : sizes) {
+        const auto world = MakeWorld(n_locs, n_per_loc);
+        const int repeats = n_locs >= 1000 ? 1 : 3;
+        TimeJump<TimeJumpModel>::Stats stats;
+        const auto old_ns = TimeOn(world, repeats, [](World& w) { OneByOne(w); });
+        const auto new_ns = TimeOn(world, repeats, [&stats](World& w) { stats = Together(w); });
+        const auto n = n_locs * n_per_loc;
+        std::printf("%zu containers, %zu instances: %zu updates, %zu applied, %zu rounds\n", n_locs, n, stats.updated,
+                    stats.applied, stats.rounds);
+        Bench::Row("24h wait, CatchUp per container", n, old_ns, "wait");
+        Bench::Row("24h wait, TimeJump", n, new_ns, "wait");
+    }
+    return 0;
+}
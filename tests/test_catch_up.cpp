@@ -0,0 +1,169 @@
+#include "CatchUp.h"
+#include "Check.h"
+#include "ModelWorld.h"
+
+// CatchUp against the loop it replaced in Manager::UpdateInventory(ref), on random worlds: the whole world has to end
+// up bit for bit the same, the location that caught up as well as the rest of the sources
+namespace {
+    using namespace ModelWorld;
+
+    constexpr RefID loc = 0x100;
+    constexpr RefID other_loc = 0x200;
+
+    // the loop before CatchUp: step to the earliest next update time of any instance, everything at every step
+    void OldCatchUp(World& world) {
+        while (true) {
+            std::set<float> times;
+            for (const auto i : world.GetSourcesAt(loc)) {
+                for (const auto& inst : world.sources[i].data.at(loc)) {
+                    if (const auto h = world.sources[i].GetNextUpdateTime(inst); h > 0) times.insert(h);
+                }
+            }
+            if (times.empty()) break;
+            const auto t = *times.begin() + 0.000028f;
+            if (t >= world.curr_time || !world.UpdateInventory(loc, t)) break;
+        }
+        world.UpdateInventory(loc, world.curr_time);
+    }
+
+    // a_small_inventory 0: no full steps for small inventories, so that they are tested too
+    CatchUp<CatchUpModel>::Stats NewCatchUp(World& world, const size_t a_small_inventory) {
+        CatchUpModel model{world, loc, {}};
+        CatchUp catch_up(model, world.curr_time, a_small_inventory);
+        catch_up.Run();
+        world.UpdateInventory(loc, world.curr_time);
+        return catch_up.GetStats();
+    }
+
+    struct Random {
+        std::mt19937 rng;
+        explicit Random(const uint32_t seed) : rng(seed) {}
+        int Int(const int lo, const int hi) { return std::uniform_int_distribution(lo, hi)(rng); }
+        float Real(const float lo, const float hi) { return std::uniform_real_distribution(lo, hi)(rng); }
+        bool Chance(const float p) { return Real(0.f, 1.f) < p; }
+        template <typename T>
+        const T& Pick(const std::vector<T>& v) { return v[static_cast<size_t>(Int(0, static_cast<int>(v.size()) - 1))]; }
+    };
+
+    FormID StageFormID(const size_t src, const size_t no) { return static_cast<FormID>(0x1000 * (src + 1) + no); }
+
+    World MakeWorld(const uint32_t seed) {
+        Random r(seed);
+        World world;
+        world.curr_time = r.Real(15.f, 250.f);
+        world.forgetting_time = r.Pick(std::vector{0.5f, 24.f, 1000.f});
+
+        const auto n_sources = static_cast<size_t>(r.Int(1, 7));
+        world.sources.resize(n_sources);
+        std::vector<FormID> items;  // every stage form, they can modulate other sources
+        for (size_t i = 0; i < n_sources; ++i) {
+            auto& src = world.sources[i];
+            const auto n_stages = static_cast<size_t>(r.Chance(0.15f) ? 1 : r.Int(2, 6));
+            for (size_t k = 0; k < n_stages; ++k) {
+                const float duration = r.Chance(0.2f) ? r.Real(0.02f, 0.3f) : r.Real(0.5f, 15.f);
+                src.stages.push_back({StageFormID(i, k), duration, k > 0 && r.Chance(0.15f)});
+                items.push_back(StageFormID(i, k));
+            }
+            // decays into the first stage of another source, or into nothing we track
+            if (n_stages == 1 && r.Chance(0.5f)) src.settings.decayed_id = src.stages[0].formid;
+            else if (r.Chance(0.6f)) src.settings.decayed_id = StageFormID(static_cast<size_t>(r.Int(0, static_cast<int>(n_sources) - 1)), 0);
+            else src.settings.decayed_id = static_cast<FormID>(0x9000 + i);
+        }
+        const std::vector<FormID> plain_modulators{0xA001, 0xA002, 0xA003};
+        for (size_t i = 0; i < n_sources; ++i) {
+            auto& src = world.sources[i];
+            src.freeze = r.Chance(0.1f);
+            const auto modulator = [&] { return r.Chance(0.5f) ? r.Pick(plain_modulators) : r.Pick(items); };
+            for (int j = r.Chance(0.4f) ? r.Int(1, 2) : 0; j > 0; --j) {
+                const auto formid = modulator();
+                if (src.settings.transformers.contains(formid)) continue;
+                const FormID result = r.Chance(0.5f) ? StageFormID(static_cast<size_t>(r.Int(0, static_cast<int>(n_sources) - 1)), 0) : 0xB000 + formid;
+                const auto duration = r.Real(0.5f, 8.f);
+                std::vector<StageNo> allowed;
+                for (StageNo no = 0; no < src.stages.size(); ++no) {
+                    if (r.Chance(0.6f)) allowed.push_back(no);
+                }
+                src.settings.transformers[formid] = {result, duration, allowed};
+                src.settings.transformers_order.push_back(formid);
+            }
+            for (int j = r.Int(0, 3); j > 0; --j) {
+                const auto formid = modulator();
+                if (src.settings.delayers.contains(formid)) continue;
+                src.settings.delayers[formid] = r.Pick(std::vector{0.f, 0.5f, 2.f, 1.5f, -0.5f, 0.25f});
+                src.settings.delayers_order.push_back(formid);
+            }
+            src.Finish();
+        }
+
+        for (const auto& [where, n_max] : {std::pair{loc, 40}, std::pair{other_loc, 10}}) {
+            auto& inventory = world.inventories[where];
+            for (size_t i = 0; i < n_sources; ++i) {
+                auto& src = world.sources[i];
+                for (int j = r.Int(0, n_max); j > 0; --j) {
+                    const auto no = static_cast<StageNo>(r.Int(0, static_cast<int>(src.stages.size()) - 1));
+                    const float start = r.Chance(0.3f) && !src.data[where].empty() ? src.data[where].back().start_time + r.Real(-0.02f, 0.02f)
+                                                                                  : r.Real(0.f, 12.f);
+                    auto& inst = src.data[where].emplace_back(start, no, r.Int(1, 4));
+                    inst.xtra.form_id = src.stages[no].formid;
+                    inst.xtra.is_fake = src.stages[no].fake;
+                    ++src.n_instances;
+                    inventory[inst.xtra.form_id] += inst.count;
+                }
+                // a chain of almost same ones: the first takes the second, the second the third and stays
+                if (r.Chance(0.3f)) {
+                    const auto no = static_cast<StageNo>(r.Int(0, static_cast<int>(src.stages.size()) - 1));
+                    const float start = r.Real(0.f, 12.f);
+                    const auto n = r.Int(3, 5);
+                    for (int k = 0; k < n; ++k) {
+                        auto& inst = src.data[where].emplace_back(start + 0.009f * static_cast<float>(k), no, r.Int(1, 4));
+                        inst.xtra.form_id = src.stages[no].formid;
+                        inst.xtra.is_fake = src.stages[no].fake;
+                        ++src.n_instances;
+                        inventory[inst.xtra.form_id] += inst.count;
+                    }
+                }
+                if (src.data[where].empty()) src.data.erase(where);
+                else {
+                    if (r.Chance(0.5f)) src.dirty_locs.insert(where);
+                    // due, later, or cleaned up for good
+                    if (r.Chance(0.6f)) src.cleanup_schedule.Set(where, world.curr_time + r.Real(-1.f, 1.f));
+                }
+                src.last_cleanup = r.Chance(0.3f) ? -1.f : world.curr_time - 0.5f;
+            }
+            for (const auto formid : plain_modulators) {
+                if (r.Chance(0.4f)) inventory[formid] = 1;
+            }
+        }
+        return world;
+    }
+
+    CatchUp<CatchUpModel>::Stats total;
+    size_t n_worlds_moved = 0;
+
+    bool Compare(const uint32_t seed) {
+        const auto world = MakeWorld(seed);
+        auto old_world = world;
+        auto new_world = world;
+        OldCatchUp(old_world);
+        const auto stats = NewCatchUp(new_world, seed % 4 ? 0 : CatchUp<CatchUpModel>::small_inventory);
+        total.steps += stats.steps;
+        total.full_steps += stats.full_steps;
+        total.updated += stats.updated;
+        total.modulated += stats.modulated;
+        if (!old_world.Identical(world)) ++n_worlds_moved;
+        if (old_world.Identical(new_world)) return true;
+        std::printf("seed %u differs\n", seed);
+        return false;
+    }
+}
+
+int main() {
+    for (uint32_t seed = 1; seed <= 600; ++seed) {
+        if (!CHECK(Compare(seed))) break;
+    }
+    std::printf("%zu steps, %zu full, %zu updates, %zu modulations\n", total.steps, total.full_steps, total.updated, total.modulated);
+    CHECK(n_worlds_moved > 300);
+    // the point of it: most steps are not full ones
+    CHECK(total.full_steps * 4 < total.steps);
+    return Check::Result();
+}
@@ -0,0 +1,163 @@
+#include "Check.h"
+#include "ModelWorld.h"
+
+// Evolution::Rules::CleanUpData with its schedule against cleaning up every location at every call, on random worlds:
+// the clock goes on (and sometimes back), instances get changed and marked dirty in between, and after every clean up
+// the data has to be bit for bit the same. what changes with time alone, forgetting and instances with different
+// slopes drifting together, only the schedule catches
+namespace {
+    using namespace ModelWorld;
+
+    struct Random {
+        std::mt19937 rng;
+        explicit Random(const uint32_t seed) : rng(seed) {}
+        int Int(const int lo, const int hi) { return std::uniform_int_distribution(lo, hi)(rng); }
+        float Real(const float lo, const float hi) { return std::uniform_real_distribution(lo, hi)(rng); }
+        bool Chance(const float p) { return Real(0.f, 1.f) < p; }
+    };
+
+    FormID StageFormID(const size_t src, const size_t no) { return static_cast<FormID>(0x1000 * (src + 1) + no); }
+
+    constexpr int n_locs = 6;
+    constexpr std::array slopes{0.f, 0.25f, 0.5f, 1.f, 1.5f, 2.f, -0.5f};
+
+    void AddInstance(Random& r, Source& src, const RefID loc, const float start, const float t) {
+        const auto no = static_cast<StageNo>(r.Int(0, static_cast<int>(src.stages.size()) - 1));
+        auto& inst = src.data[loc].emplace_back(start, no, r.Int(1, 3));
+        src.SetStageXtra(inst.xtra, no);
+        inst.SetDelay(t, slopes[static_cast<size_t>(r.Int(0, slopes.size() - 1))], 0xA001);
+        src.ChangeNInstances(1);
+        src.MarkDirty(loc);
+    }
+
+    World MakeWorld(const uint32_t seed) {
+        Random r(seed);
+        World world;
+        world.curr_time = r.Real(5.f, 50.f);
+        world.forgetting_time = r.Chance(0.5f) ? r.Real(0.2f, 3.f) : 24.f;
+        world.sources.resize(static_cast<size_t>(r.Int(1, 3)));
+        for (size_t i = 0; i < world.sources.size(); ++i) {
+            auto& src = world.sources[i];
+            for (size_t k = 0, n = static_cast<size_t>(r.Int(1, 4)); k < n; ++k) {
+                src.stages.push_back({StageFormID(i, k), r.Chance(0.3f) ? r.Real(0.05f, 0.5f) : r.Real(1.f, 10.f)});
+            }
+            src.settings.decayed_id = 0x9000;
+            src.Finish();
+            for (RefID loc = 1; loc <= n_locs; ++loc) {
+                for (int j = r.Int(0, 12); j > 0; --j) {
+                    // near the one before half of the time, so that there is something to drift together
+                    const auto& instances = src.data[loc];
+                    const float start = !instances.empty() && r.Chance(0.5f) ? instances.back().start_time + r.Real(-0.014f, 0.014f)
+                                                                            : world.curr_time - r.Real(0.f, 20.f);
+                    AddInstance(r, src, loc, start, start);
+                }
+                if (src.data[loc].empty()) src.data.erase(loc);
+            }
+        }
+        return world;
+    }
+
+    bool SameData(const World& a, const World& b) {
+        for (size_t i = 0; i < a.sources.size(); ++i) {
+            const auto& x = a.sources[i];
+            const auto& y = b.sources[i];
+            if (x.n_instances != y.n_instances || x.data.size() != y.data.size()) return false;
+            for (const auto& [loc, instances] : x.data) {
+                const auto it = y.data.find(loc);
+                if (it == y.data.end() || it->second.size() != instances.size()) return false;
+                for (size_t k = 0; k < instances.size(); ++k) {
+                    if (!instances[k].Identical(it->second[k])) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    size_t n_cleaned = 0;     // locations the scheduled clean ups looked at
+    size_t n_locations = 0;   // and the ones a full pass would have
+    size_t n_undirty = 0;     // locations that changed in a clean up without being dirty
+
+    bool Run(const uint32_t seed) {
+        auto scheduled = MakeWorld(seed);
+        auto full = scheduled;
+        Random r(seed * 7919u);
+        for (int step = 0; step < 150; ++step) {
+            // mostly forward, now and then far ahead or back
+            float dt = r.Real(0.f, 0.4f);
+            if (r.Chance(0.05f)) dt = -r.Real(0.f, 3.f);
+            else if (r.Chance(0.05f)) dt = r.Real(5.f, 40.f);
+            scheduled.curr_time = full.curr_time = std::max(0.f, scheduled.curr_time + dt);
+
+            // the same change to both, they hold the same data
+            if (r.Chance(0.4f)) {
+                const auto i = static_cast<Slot>(r.Int(0, static_cast<int>(scheduled.sources.size()) - 1));
+                const auto loc = static_cast<RefID>(r.Int(1, n_locs));
+                const auto op = r.Int(0, 2);
+                const auto seed_op = static_cast<uint32_t>(r.Int(0, 1 << 30));
+                for (auto* world : {&scheduled, &full}) {
+                    Random rr(seed_op);
+                    auto& src = world->sources[i];
+                    const auto it = src.data.find(loc);
+                    if (op == 0 || it == src.data.end()) {
+                        const auto t = world->curr_time;
+                        const float start = it != src.data.end() ? it->second.back().start_time + rr.Real(-0.014f, 0.014f) : t;
+                        AddInstance(rr, src, loc, start, t);
+                        continue;
+                    }
+                    auto& inst = it->second[static_cast<size_t>(rr.Int(0, static_cast<int>(it->second.size()) - 1))];
+                    if (op == 1) inst.SetDelay(world->curr_time, slopes[static_cast<size_t>(rr.Int(0, slopes.size() - 1))], 0xA002);
+                    else inst.count -= std::min(inst.count, 1);
+                    src.MarkDirty(loc);
+                }
+            }
+
+            for (Slot i = 0; i < scheduled.sources.size(); ++i) {
+                auto& src = scheduled.sources[i];
+                if (src.data.empty()) continue;
+                const auto before = src.data;
+                auto dirty = src.dirty_locs;
+                if (src.last_cleanup >= 0.f && scheduled.curr_time >= src.last_cleanup) {
+                    std::set<RefID> due = dirty;
+                    auto schedule = src.cleanup_schedule;
+                    schedule.PopDue(scheduled.curr_time, due);
+                    for (const auto loc : due) n_cleaned += src.data.contains(loc);
+                    n_locations += src.data.size();
+                }
+                scheduled.CleanUp(i);
+                for (const auto& [loc, instances] : before) {
+                    if (dirty.contains(loc)) continue;
+                    const auto it = src.data.find(loc);
+                    if (it == src.data.end() || it->second.size() != instances.size()) ++n_undirty;
+                    else {
+                        for (size_t k = 0; k < instances.size(); ++k) {
+                            if (!instances[k].Identical(it->second[k])) {
+                                ++n_undirty;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                full.sources[i].last_cleanup = -1.f;
+                full.CleanUp(i);
+            }
+            if (!SameData(scheduled, full)) {
+                std::printf("seed %u differs at step %d, t %f\n", seed, step, static_cast<double>(scheduled.curr_time));
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    for (uint32_t seed = 1; seed <= 300; ++seed) {
+        if (!CHECK(Run(seed))) break;
+    }
+    std::printf("%zu of %zu locations cleaned up, %zu changed without being dirty\n", n_cleaned, n_locations, n_undirty);
+    // what it is for: the rest is left alone
+    CHECK(n_cleaned * 2 < n_locations);
+    // and what it has to catch happens
+    CHECK(n_undirty > 100);
+    return Check::Result();
+}
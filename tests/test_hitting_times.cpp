@@ -0,0 +1,76 @@
+#include "Check.h"
+#include "HittingTimes.h"
+
+// Every SIMD level has to give bit for bit the results of StageInstance::GetHittingTime, including the tails that
+// don't fill a register and the clamped / zero / negative slopes.
+namespace {
+    using HittingTimes::SimdLevel;
+
+    // StageInstance::GetHittingTime with GetDelaySlope inlined
+    float GetHittingTime(const float delay_start, const float elapsed, const float delay_mag, const float schranke) {
+        const float slope = std::min(std::max(-1000.f, delay_mag), 1000.f);
+        return delay_start + (schranke - elapsed) / (slope + std::numeric_limits<float>::epsilon());
+    }
+
+    struct Rows {
+        std::vector<float> delay_start, elapsed, delay_mag, schranke;
+
+        explicit Rows(const size_t n, std::mt19937& rng) {
+            std::uniform_real_distribution<float> time(0.f, 20000.f);
+            std::uniform_real_distribution<float> stage(0.f, 500.f);
+            std::uniform_real_distribution<float> mag(-3.f, 3.f);
+            // the slopes the game produces and the edges of the clamp
+            const std::array<float, 9> special{0.f, -0.f, 1.f, 0.5f, 2000.f, -2000.f, 1000.f, 1e-12f, -1e-12f};
+            for (size_t i = 0; i < n; ++i) {
+                delay_start.push_back(time(rng));
+                elapsed.push_back(stage(rng) - 50.f);
+                delay_mag.push_back(i % 3 ? mag(rng) : special[i % special.size()]);
+                schranke.push_back(i % 7 ? stage(rng) : 0.f);
+            }
+        }
+    };
+
+    bool SameBits(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    void EveryLevelMatchesTheScalarFormula() {
+        std::mt19937 rng(3);
+        for (const size_t n : {size_t{0}, size_t{1}, size_t{3}, size_t{4}, size_t{7}, size_t{8}, size_t{9},
+                               size_t{31}, size_t{1000}, size_t{10001}}) {
+            const Rows rows(n, rng);
+            std::vector<float> expected(n);
+            for (size_t i = 0; i < n; ++i) {
+                expected[i] = GetHittingTime(rows.delay_start[i], rows.elapsed[i], rows.delay_mag[i], rows.schranke[i]);
+            }
+            for (const auto level : {SimdLevel::kScalar, SimdLevel::kSSE, SimdLevel::kAVX}) {
+                std::vector<float> out(n);
+                HittingTimes::Evaluate(level, rows.delay_start.data(), rows.elapsed.data(), rows.delay_mag.data(),
+                                       rows.schranke.data(), out.data(), n);
+                if (!CHECK(SameBits(out, expected))) {
+                    std::fprintf(stderr, "  level %s, n %zu\n", HittingTimes::GetSimdLevelName(level), n);
+                }
+            }
+        }
+    }
+
+    void FlagDueMatchesTheComparison() {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> time(0.f, 100.f);
+        for (const size_t n : {size_t{0}, size_t{3}, size_t{4}, size_t{13}, size_t{4096}}) {
+            std::vector<float> times(n);
+            for (auto& t : times) t = time(rng);
+            if (n > 2) times[1] = 50.f;  // exactly now counts as due
+            std::vector<uint8_t> due(n, 2);
+            HittingTimes::FlagDue(times.data(), 50.f, due.data(), n);
+            for (size_t i = 0; i < n; ++i) CHECK(due[i] == (times[i] <= 50.f ? 1 : 0));
+        }
+    }
+}
+
+int main() {
+    std::printf("detected: %s\n", HittingTimes::GetSimdLevelName());
+    EveryLevelMatchesTheScalarFormula();
+    FlagDueMatchesTheComparison();
+    return Check::Result();
+}
@@ -0,0 +1,86 @@
+#include "Check.h"
+#include "InstanceOps.h"
+#include "ModelInstance.h"
+
+// InstanceOps::MergeAlmostSame against the pairwise loop it replaced in CleanUpData
+namespace {
+    void PairwiseMerge(std::vector<ModelInstance>& instances, const float curr_time) {
+        for (auto it = instances.begin(); it + 1 != instances.end(); ++it) {
+            size_t ind = 1;
+            for (auto it2 = it + ind; it2 != instances.end(); it2 = it + ind) {
+                ++ind;
+                if (it2->count <= 0) continue;
+                if (it->AlmostSameExceptCount(*it2, curr_time)) {
+                    it->count += it2->count;
+                    it2->count = 0;
+                }
+            }
+        }
+    }
+
+    bool SameCounts(const std::vector<ModelInstance>& a, const std::vector<ModelInstance>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (!a[i].Identical(b[i])) return false;
+        }
+        return true;
+    }
+
+    int n_merged = 0;
+
+    bool Compare(const std::vector<ModelInstance>& instances, const float curr_time) {
+        if (instances.empty()) return true;
+        auto expected = instances;
+        auto actual = instances;
+        PairwiseMerge(expected, curr_time);
+        InstanceOps::MergeAlmostSame(actual, curr_time);
+        for (size_t i = 0; i < instances.size(); ++i) n_merged += expected[i].count != instances[i].count;
+        return SameCounts(expected, actual);
+    }
+
+    // start times a step apart, so whether two links of the chain merge depends on which side of 0.015h the step falls
+    void Chains() {
+        const std::array<float, 6> steps{0.0149f, 0.01499f, 0.015f, 0.01501f, 0.0151f, 0.0075f};
+        for (const auto step : steps) {
+            // both sides of InstanceOps::small_location
+            for (const int len : {2, 3, 4, 5, 7, 11, 31, 32, 33, 40, 64}) {
+                std::vector<ModelInstance> instances;
+                for (int k = 0; k < len; ++k) instances.emplace_back(100.f + k * step, 1u, 1 + k);
+                CHECK(Compare(instances, 120.f));
+                std::ranges::reverse(instances);
+                CHECK(Compare(instances, 120.f));
+                // every other link slowed down, elapsed then straddles the tolerance too
+                for (int k = 0; k < len; k += 2) instances[k].SetDelay(110.f, 1.0004f, 7);
+                CHECK(Compare(instances, 130.f));
+            }
+        }
+    }
+
+    void Random() {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> size(0, 80);
+        std::uniform_int_distribution<int> small(0, 3);
+        std::uniform_int_distribution<int> count(-1, 5);
+        std::uniform_real_distribution<float> jitter(-0.02f, 0.02f);
+        std::uniform_real_distribution<float> base(0.f, 0.2f);
+        for (int round = 0; round < 20000; ++round) {
+            const auto n = size(rng);
+            std::vector<ModelInstance> instances;
+            for (int i = 0; i < n; ++i) {
+                // few distinct starts, stages and forms so most pairs are candidates
+                const float start = 50.f + small(rng) * base(rng) + jitter(rng);
+                auto& inst = instances.emplace_back(start, static_cast<unsigned int>(small(rng) % 2), count(rng));
+                inst.xtra.form_id = 0x100 + small(rng) % 2;
+                if (small(rng) == 0) inst.SetDelay(start + 0.5f, small(rng) * 0.5f, 0x200);
+            }
+            if (!CHECK(Compare(instances, 60.f + base(rng)))) return;
+        }
+    }
+}
+
+int main() {
+    Chains();
+    Random();
+    CHECK(n_merged > 0);
+    return Check::Result();
+}
@@ -0,0 +1,110 @@
+#include "Check.h"
+#include "InstanceOps.h"
+#include "ModelInstance.h"
+
+// InstanceOps::Take against moving the instances one at a time the way MoveInstances did before it: the same ones
+// leave, in the same order, what stays keeps its order, the split one keeps the rest of its count
+namespace {
+    using Location = std::vector<ModelInstance>;
+
+    struct Moved {
+        Location from;
+        Location to;
+        Count count;
+    };
+
+    // one at a time with an erase each, stable_sort so that ties go the same way as in Take
+    Moved OneByOne(Location from, const FormID form, Count count, const bool older_first, const float curr_time) {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < from.size(); ++i) {
+            if (from[i].xtra.form_id == form) candidates.push_back(i);
+        }
+        std::ranges::stable_sort(candidates, [&](const size_t a, const size_t b) {
+            return older_first ? from[a].GetElapsed(curr_time) > from[b].GetElapsed(curr_time)
+                               : from[a].GetElapsed(curr_time) < from[b].GetElapsed(curr_time);
+        });
+        Location to;
+        std::vector<size_t> removed;
+        for (const auto index : candidates) {
+            if (!count) break;
+            size_t shift = 0;
+            for (const auto r : removed) shift += index > r;
+            auto& instance = from[index - shift];
+            if (count <= instance.count) {
+                instance.count -= count;
+                to.push_back(instance);
+                to.back().count = count;
+                count = 0;
+                break;
+            }
+            count -= instance.count;
+            to.push_back(instance);
+            from.erase(from.begin() + static_cast<std::ptrdiff_t>(index - shift));
+            removed.push_back(index);
+        }
+        return {std::move(from), std::move(to), count};
+    }
+
+    Moved WithTake(Location from, const FormID form, const Count count, const bool older_first, const float curr_time,
+                   size_t& n_sink_calls) {
+        Location to;
+        const auto taken = InstanceOps::Take(from, form, count, older_first, curr_time, [&](const size_t n) {
+            ++n_sink_calls;
+            return n ? &to : nullptr;
+        });
+        if (!taken.split) return {std::move(from), std::move(to), taken.count};
+        // the split one is still in from, with what was not taken
+        const bool in_from = taken.split >= from.data() && taken.split < from.data() + from.size();
+        if (!CHECK(in_from)) return {};
+        to.push_back(*taken.split);
+        to.back().count = taken.count;
+        return {std::move(from), std::move(to), 0};
+    }
+
+    bool Same(const Location& a, const Location& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (!a[i].Identical(b[i])) return false;
+        }
+        return true;
+    }
+
+    size_t n_split = 0;
+    size_t n_short = 0;
+
+    bool Compare(const Location& from, const FormID form, const Count count, const bool older_first, const float curr_time) {
+        const auto expected = OneByOne(from, form, count, older_first, curr_time);
+        size_t n_sink_calls = 0;
+        const auto actual = WithTake(from, form, count, older_first, curr_time, n_sink_calls);
+        if (n_sink_calls > 1) return false;
+        n_split += expected.count == 0 && !expected.to.empty() && expected.to.size() + expected.from.size() > from.size();
+        n_short += expected.count > 0;
+        return expected.count == actual.count && Same(expected.from, actual.from) && Same(expected.to, actual.to);
+    }
+}
+
+int main() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> size(0, 40);
+    std::uniform_int_distribution<int> small(0, 3);
+    std::uniform_int_distribution<int> count(1, 4);
+    std::uniform_real_distribution<float> start(0.f, 24.f);
+    for (int round = 0; round < 20000; ++round) {
+        const auto n = size(rng);
+        Location from;
+        int total = 0;
+        for (int i = 0; i < n; ++i) {
+            // same start times now and then, the order of ties has to hold too
+            const float st = small(rng) == 0 && !from.empty() ? from.back().start_time : 100.f + start(rng);
+            auto& inst = from.emplace_back(st, static_cast<unsigned int>(small(rng)), count(rng));
+            inst.xtra.form_id = 0x100 + small(rng) % 2;
+            if (small(rng) == 0) inst.SetDelay(st + 0.5f, small(rng) * 0.5f, 0x200);
+            if (inst.xtra.form_id == 0x100) total += inst.count;
+        }
+        const Count to_move = std::uniform_int_distribution<int>(1, total + 3)(rng);
+        if (!CHECK(Compare(from, 0x100, to_move, small(rng) % 2 == 0, 130.f))) break;
+    }
+    CHECK(n_split > 0);
+    CHECK(n_short > 0);
+    return Check::Result();
+}
@@ -0,0 +1,62 @@
+#include "Check.h"
+#include "SlotMap.h"
+
+namespace {
+    struct Tracked {
+        inline static int alive = 0;
+        int value = 0;
+
+        explicit Tracked(const int a_value) : value(a_value) { ++alive; }
+        Tracked(const Tracked& other) : value(other.value) { ++alive; }
+        ~Tracked() { --alive; }
+    };
+
+    void AddressesStayPut() {
+        SlotMap<Tracked, 4> map;
+        std::vector<const Tracked*> addresses;
+        for (int i = 0; i < 37; ++i) addresses.push_back(&map.emplace_back(i));
+        CHECK(map.size() == 37);
+        for (int i = 0; i < 37; ++i) {
+            CHECK(&map[i] == addresses[i]);
+            CHECK(map[i].value == i);
+        }
+        CHECK(&map.back() == addresses.back());
+    }
+
+    void IteratesInIndexOrder() {
+        SlotMap<Tracked, 4> map;
+        for (int i = 0; i < 10; ++i) map.emplace_back(i);
+        int expected = 0;
+        for (const auto& t : map) CHECK(t.value == expected++);
+        CHECK(expected == 10);
+
+        const auto& const_map = map;
+        const std::vector<int> values = [&] {
+            std::vector<int> v;
+            for (auto it = const_map.begin(); it != const_map.end(); ++it) v.push_back(it->value);
+            return v;
+        }();
+        CHECK(values.size() == 10 && values.front() == 0 && values.back() == 9);
+    }
+
+    void ClearDestroysAndReusesChunks() {
+        SlotMap<Tracked, 4> map;
+        for (int i = 0; i < 9; ++i) map.emplace_back(i);
+        CHECK(Tracked::alive == 9);
+        const auto* first = &map[0];
+        map.clear();
+        CHECK(map.empty());
+        CHECK(Tracked::alive == 0);
+        CHECK(map.begin() == map.end());
+        // the chunks are kept, so the first slot comes back at the same address
+        CHECK(&map.emplace_back(100) == first);
+        CHECK(map.size() == 1 && map[0].value == 100);
+    }
+}
+
+int main() {
+    AddressesStayPut();
+    IteratesInIndexOrder();
+    ClearDestroysAndReusesChunks();
+    return Check::Result();
+}
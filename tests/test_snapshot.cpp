@@ -0,0 +1,65 @@
+#include "Check.h"
+#include "Snapshot.h"
+
+// Snapshot keeps the last version per thread: a load after a publish sees it, two snapshots of the same type don't
+// see each other's versions, and readers on other threads never see a version go back
+namespace {
+    void Basics() {
+        Snapshot<int> a;
+        CHECK(*a.Load() == 0);
+        a.Publish(std::make_shared<const int>(1));
+        CHECK(*a.Load() == 1);
+        CHECK(*a.Load() == 1);
+
+        Snapshot<int> b;
+        CHECK(*b.Load() == 0);
+        b.Publish(std::make_shared<const int>(2));
+        CHECK(*a.Load() == 1);
+        CHECK(*b.Load() == 2);
+        a.Publish(std::make_shared<const int>(3));
+        CHECK(*a.Load() == 3);
+        CHECK(*b.Load() == 2);
+        CHECK(a.GetNPublished() == 2);
+    }
+
+    // a new snapshot with as many publishes as a gone one, maybe at its address
+    void Replaced() {
+        auto first = std::make_unique<Snapshot<int>>();
+        first->Publish(std::make_shared<const int>(1));
+        CHECK(*first->Load() == 1);
+        first.reset();
+        auto second = std::make_unique<Snapshot<int>>();
+        second->Publish(std::make_shared<const int>(2));
+        CHECK(*second->Load() == 2);
+    }
+
+    void Readers() {
+        Snapshot<int> snapshot;
+        constexpr int n_versions = 20000;
+        std::atomic<bool> went_back = false;
+        std::atomic<bool> done = false;
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                int last = 0;
+                while (!done.load()) {
+                    const auto value = *snapshot.Load();
+                    if (value < last) went_back = true;
+                    last = value;
+                }
+                if (*snapshot.Load() != n_versions) went_back = true;
+            });
+        }
+        for (int v = 1; v <= n_versions; ++v) snapshot.Publish(std::make_shared<const int>(v));
+        done = true;
+        for (auto& t : readers) t.join();
+        CHECK(!went_back.load());
+    }
+}
+
+int main() {
+    Basics();
+    Replaced();
+    Readers();
+    return Check::Result();
+}
@@ -0,0 +1,133 @@
+#include "Check.h"
+#include "SpatialHashGrid.h"
+
+namespace {
+    using Entry = SpatialHashGrid::Entry;
+
+    float Dist2(const Entry& e, const float x, const float y, const float z) {
+        return (e.x - x) * (e.x - x) + (e.y - y) * (e.y - y) + (e.z - z) * (e.z - z);
+    }
+
+    // what Query has to find: every entry of the bases in the space within range
+    std::vector<RefID> BruteForce(const std::unordered_map<RefID, Entry>& entries, const FormID space, const float x,
+                                  const float y, const float z, const float range, const std::vector<FormID>& bases) {
+        std::vector<RefID> out;
+        for (const auto& e : entries | std::views::values) {
+            if (e.space == space && std::ranges::find(bases, e.base) != bases.end() && Dist2(e, x, y, z) <= range * range) {
+                out.push_back(e.refid);
+            }
+        }
+        std::ranges::sort(out);
+        return out;
+    }
+
+    bool NearestFirst(const std::vector<Entry>& found, const float x, const float y, const float z) {
+        return std::ranges::is_sorted(found, {}, [&](const Entry& e) { return Dist2(e, x, y, z); });
+    }
+
+    std::vector<RefID> Refids(const std::vector<Entry>& found) {
+        std::vector<RefID> out;
+        for (const auto& e : found) out.push_back(e.refid);
+        std::ranges::sort(out);
+        return out;
+    }
+
+    void InsertReplacesAndErases() {
+        SpatialHashGrid grid(100.f);
+        grid.Insert({1, 0x10, 0x3C, 50.f, 50.f, 0.f, 5.f});
+        grid.Insert({2, 0x10, 0x3C, 60.f, 50.f, 0.f, 30.f});
+        CHECK(grid.size() == 2);
+        CHECK(grid.GetNBuckets() == 1);
+        CHECK(grid.GetMaxRadius() == 30.f);
+
+        // moved into the next bucket: the old one must not keep it
+        grid.Insert({1, 0x10, 0x3C, 150.f, 50.f, 0.f, 5.f});
+        CHECK(grid.size() == 2);
+        CHECK(grid.GetNBuckets() == 2);
+        CHECK(grid.Find(1) && grid.Find(1)->x == 150.f);
+        std::vector<Entry> out;
+        grid.Query(0x3C, 50.f, 50.f, 0.f, 20.f, {0x10}, out);
+        CHECK(out.size() == 1 && out[0].refid == 2);
+
+        CHECK(grid.Erase(2));
+        CHECK(!grid.Erase(2));
+        CHECK(!grid.Find(2));
+        CHECK(grid.GetNBuckets() == 1);
+        grid.Query(0x3C, 50.f, 50.f, 0.f, 20.f, {0x10}, out);
+        CHECK(out.empty());
+
+        grid.Clear();
+        CHECK(grid.size() == 0 && grid.GetNBuckets() == 0 && grid.GetMaxRadius() == 0.f);
+    }
+
+    // floor, not truncation: -1 and 1 are in different buckets, and the range reaches across the origin
+    void AcrossTheOrigin() {
+        SpatialHashGrid grid(100.f);
+        grid.Insert({1, 0x10, 0x3C, -1.f, -1.f, 0.f, 0.f});
+        grid.Insert({2, 0x10, 0x3C, 1.f, 1.f, 0.f, 0.f});
+        grid.Insert({3, 0x10, 0x3C, -99.f, 0.f, 0.f, 0.f});
+        CHECK(grid.GetNBuckets() == 3);
+        std::vector<Entry> out;
+        grid.Query(0x3C, 0.5f, 0.5f, 0.f, 3.f, {0x10}, out);
+        CHECK((Refids(out) == std::vector<RefID>{1, 2}));
+        CHECK(out[0].refid == 2);
+    }
+
+    // bases and spaces keep entries apart even at the same position
+    void BasesAndSpaces() {
+        SpatialHashGrid grid;
+        grid.Insert({1, 0x10, 0x3C, 0.f, 0.f, 0.f, 0.f});
+        grid.Insert({2, 0x11, 0x3C, 0.f, 0.f, 0.f, 0.f});
+        grid.Insert({3, 0x10, 0x4D, 0.f, 0.f, 0.f, 0.f});
+        std::vector<Entry> out;
+        grid.Query(0x3C, 0.f, 0.f, 0.f, 10.f, {0x10}, out);
+        CHECK(Refids(out) == std::vector<RefID>{1});
+        grid.Query(0x3C, 0.f, 0.f, 0.f, 10.f, {0x10, 0x11}, out);
+        CHECK((Refids(out) == std::vector<RefID>{1, 2}));
+        grid.Query(0x4D, 0.f, 0.f, 0.f, 10.f, {0x11}, out);
+        CHECK(out.empty());
+    }
+
+    // random inserts, moves and erases, every query against the brute force answer
+    void Random() {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> pos(-5000.f, 5000.f);
+        std::uniform_real_distribution<float> height(-300.f, 300.f);
+        std::uniform_real_distribution<float> range(0.f, 3000.f);
+        std::uniform_int_distribution<int> small(0, 3);
+        std::uniform_int_distribution<RefID> refid(1, 600);
+        for (const float bucket : {256.f, 1000.f, 2048.f, 9000.f}) {
+            SpatialHashGrid grid(bucket);
+            std::unordered_map<RefID, Entry> entries;
+            for (int round = 0; round < 4000; ++round) {
+                const auto id = refid(rng);
+                if (small(rng) == 0) {
+                    CHECK(grid.Erase(id) == (entries.erase(id) == 1));
+                } else {
+                    const Entry e{id, static_cast<FormID>(0x10 + small(rng)), static_cast<FormID>(0x3C + small(rng) % 2),
+                                  pos(rng), pos(rng), height(rng), 0.f};
+                    grid.Insert(e);
+                    entries[id] = e;
+                }
+                if (!CHECK(grid.size() == entries.size())) return;
+
+                const auto space = static_cast<FormID>(0x3C + small(rng) % 2);
+                std::vector<FormID> bases{static_cast<FormID>(0x10 + small(rng))};
+                if (small(rng) == 0) bases.push_back(bases[0] == 0x13 ? 0x10 : bases[0] + 1);
+                const float x = pos(rng), y = pos(rng), z = height(rng), r = range(rng);
+                std::vector<Entry> out;
+                grid.Query(space, x, y, z, r, bases, out);
+                if (!CHECK(Refids(out) == BruteForce(entries, space, x, y, z, r, bases))) return;
+                if (!CHECK(NearestFirst(out, x, y, z))) return;
+            }
+        }
+    }
+}
+
+int main() {
+    InsertReplacesAndErases();
+    AcrossTheOrigin();
+    BasesAndSpaces();
+    Random();
+    return Check::Result();
+}
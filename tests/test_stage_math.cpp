@@ -0,0 +1,104 @@
+#include "Check.h"
+#include "StageMath.h"
+
+// Differential test of StageMath against the loops it replaced in Source::UpdateStageInstance and GetDecayTime.
+// Both add up the durations in float, in the same order, so every result has to be the same bit for bit.
+namespace {
+    using No = StageMath::No;
+
+    // Source::UpdateStageInstance before StageMath, for diff >= 0
+    StageMath::Position OldForward(const std::vector<float>& durations, No no, float diff) {
+        while (diff >= durations[no]) {
+            diff -= durations[no];
+            ++no;
+            if (no >= durations.size()) break;
+        }
+        return {no, diff};
+    }
+
+    // Source::GetDecayTime before StageMath
+    float OldRemaining(const std::vector<float>& durations, No no) {
+        float total = 0;
+        for (; no < durations.size(); ++no) total += durations[no];
+        return total;
+    }
+
+    bool SameBits(const float a, const float b) { return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b); }
+
+    bool Same(const StageMath::Position& a, const StageMath::Position& b) { return a.no == b.no && SameBits(a.diff, b.diff); }
+
+    void RepresentableDurations() {
+        const std::vector<float> durations{24.f, 72.f, 0.5f, 168.f, 12.f};
+        const auto table = StageMath::Build(durations);
+        for (No no = 0; no < durations.size(); ++no) {
+            for (float diff = 0.f; diff < 400.f; diff += 0.25f) {
+                CHECK(Same(OldForward(durations, no, diff), StageMath::Forward(table, no, diff)));
+            }
+            CHECK(SameBits(OldRemaining(durations, no), StageMath::Remaining(table, no)));
+        }
+        // exactly on a boundary moves on, as diff >= duration did
+        CHECK(StageMath::Forward(table, 0, 24.f).no == 1);
+        CHECK(StageMath::Forward(table, 0, 24.f).diff == 0.f);
+        CHECK(StageMath::Forward(table, 0, 96.f).no == 2);
+        // past the last stage
+        const auto past = StageMath::Forward(table, 0, 1000.f);
+        CHECK(past.no == durations.size());
+        CHECK(past.diff == 1000.f - 276.5f);
+        CHECK(StageMath::Remaining(table, 4) == 12.f);
+        CHECK(StageMath::Remaining(table, 5) == 0.f);
+    }
+
+    void ZeroDurationStagesAreSkipped() {
+        const std::vector<float> durations{1.f, 0.f, 0.f, 2.f};
+        const auto table = StageMath::Build(durations);
+        const auto b = StageMath::Forward(table, 0, 1.5f);
+        CHECK(b.no == 3);
+        CHECK(Same(OldForward(durations, 0, 1.5f), b));
+        // a trailing zero stage is passed too
+        const std::vector<float> trailing{1.f, 0.f};
+        CHECK(Same(OldForward(trailing, 0, 1.f), StageMath::Forward(StageMath::Build(trailing), 0, 1.f)));
+    }
+
+    void RandomDurations() {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> n_stages(1, 12);
+        // 36 seconds to two months, log uniform
+        std::uniform_real_distribution<float> log_duration(std::log(0.01f), std::log(1500.f));
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+        size_t n_cases = 0;
+        for (int s = 0; s < 2000; ++s) {
+            std::vector<float> durations(n_stages(rng));
+            for (auto& d : durations) d = std::exp(log_duration(rng));
+            const auto table = StageMath::Build(durations);
+            const auto total = StageMath::Remaining(table, 0);
+
+            for (No no = 0; no < durations.size(); ++no) {
+                CHECK(SameBits(OldRemaining(durations, no), StageMath::Remaining(table, no)));
+                for (int c = 0; c < 50; ++c) {
+                    // mostly short steps, some jumps over everything
+                    const float diff = c % 5 ? unit(rng) * durations[no] * 3.f : unit(rng) * total * 1.5f;
+                    ++n_cases;
+                    CHECK(Same(OldForward(durations, no, diff), StageMath::Forward(table, no, diff)));
+                }
+                // right at and just below the boundaries the old loop met on its way
+                float at = 0;
+                for (auto k = no; k < durations.size(); ++k) {
+                    at += durations[k];
+                    for (const auto diff : {at, std::nextafter(at, 0.f), std::nextafter(at, 1e9f)}) {
+                        ++n_cases;
+                        CHECK(Same(OldForward(durations, no, diff), StageMath::Forward(table, no, diff)));
+                    }
+                }
+            }
+        }
+        std::printf("random: %zu cases, all bit identical to the old loops\n", n_cases);
+    }
+}
+
+int main() {
+    RepresentableDurations();
+    ZeroDurationStagesAreSkipped();
+    RandomDurations();
+    return Check::Result();
+}
@@ -0,0 +1,87 @@
+#include "Check.h"
+#include "SweepAndPrune.h"
+
+// SweepAndPrune::Pairs against testing every pair: the same pairs, each one once
+namespace {
+    using SweepAndPrune::Box;
+
+    bool Overlap(const Box& a, const Box& b) {
+        if (a.space != b.space) return false;
+        for (int k = 0; k < 3; ++k) {
+            if (a.max[k] < b.min[k] || b.max[k] < a.min[k]) return false;
+        }
+        return true;
+    }
+
+    std::vector<std::pair<size_t, size_t>> AllPairs(const std::vector<Box>& a, const std::vector<Box>& b) {
+        std::vector<std::pair<size_t, size_t>> out;
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < b.size(); ++j) {
+                if (Overlap(a[i], b[j])) out.emplace_back(i, j);
+            }
+        }
+        return out;
+    }
+
+    std::vector<std::pair<size_t, size_t>> Swept(const std::vector<Box>& a, const std::vector<Box>& b) {
+        std::vector<std::pair<size_t, size_t>> out;
+        SweepAndPrune::Pairs(a, b, [&](const size_t i, const size_t j) { out.emplace_back(i, j); });
+        std::ranges::sort(out);
+        return out;
+    }
+
+    void Around() {
+        const auto box = SweepAndPrune::Around(0x3C, 1.f, -2.f, 3.f, 0.5f);
+        CHECK(box.space == 0x3C);
+        CHECK(box.min[0] == 0.5f && box.min[1] == -2.5f && box.min[2] == 2.5f);
+        CHECK(box.max[0] == 1.5f && box.max[1] == -1.5f && box.max[2] == 3.5f);
+    }
+
+    // boxes that only touch count, on every axis
+    void Touching() {
+        const std::vector a{SweepAndPrune::Around(1, 0.f, 0.f, 0.f, 1.f)};
+        for (int k = 0; k < 3; ++k) {
+            float c[3]{};
+            c[k] = 2.f;
+            const std::vector b{SweepAndPrune::Around(1, c[0], c[1], c[2], 1.f)};
+            CHECK(Swept(a, b).size() == 1);
+            c[k] = 2.001f;
+            const std::vector apart{SweepAndPrune::Around(1, c[0], c[1], c[2], 1.f)};
+            CHECK(Swept(a, apart).empty());
+        }
+        // same place, other space
+        CHECK(Swept(a, {SweepAndPrune::Around(2, 0.f, 0.f, 0.f, 1.f)}).empty());
+    }
+
+    void Random() {
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> size(0, 60);
+        std::uniform_int_distribution<int> small(0, 3);
+        std::uniform_real_distribution<float> pos(-2000.f, 2000.f);
+        std::uniform_real_distribution<float> half(0.f, 400.f);
+        size_t n_pairs = 0;
+        for (int round = 0; round < 3000; ++round) {
+            std::vector<Box> a(static_cast<size_t>(size(rng)));
+            std::vector<Box> b(static_cast<size_t>(size(rng)));
+            for (auto* boxes : {&a, &b}) {
+                for (auto& box : *boxes) {
+                    // snapped positions now and then, so that equal min x and touching boxes come up
+                    const auto coord = [&] { return small(rng) == 0 ? std::round(pos(rng) / 200.f) * 200.f : pos(rng); };
+                    box = SweepAndPrune::Around(static_cast<FormID>(small(rng) % 2), coord(), coord(), coord() / 10.f,
+                                                small(rng) == 0 ? 100.f : half(rng));
+                }
+            }
+            const auto expected = AllPairs(a, b);
+            n_pairs += expected.size();
+            if (!CHECK(Swept(a, b) == expected)) return;
+        }
+        CHECK(n_pairs > 1000);
+    }
+}
+
+int main() {
+    Around();
+    Touching();
+    Random();
+    return Check::Result();
+}
@@ -0,0 +1,201 @@
+#include "Check.h"
+#include "ModelWorld.h"
+#include "TimeJump.h"
+
+// TimeJump against stepping every due location through the old loop, on random worlds after a wait. Where TimeJump
+// advances a location at once the result is the same up to rounding: same inventories, same instances, times within
+// a tolerance. The locations it leaves to CatchUp come out bit for bit the same.
+namespace {
+    using namespace ModelWorld;
+
+    // the loop before CatchUp, for one location
+    void OldCatchUp(World& world, const RefID loc) {
+        while (true) {
+            std::set<float> times;
+            for (const auto i : world.GetSourcesAt(loc)) {
+                for (const auto& inst : world.sources[i].data.at(loc)) {
+                    if (const auto h = world.sources[i].GetNextUpdateTime(inst); h > 0) times.insert(h);
+                }
+            }
+            if (times.empty()) break;
+            const auto t = *times.begin() + 0.000028f;
+            if (t >= world.curr_time || !world.UpdateInventory(loc, t)) break;
+        }
+        world.UpdateInventory(loc, world.curr_time);
+    }
+
+    struct Random {
+        std::mt19937 rng;
+        explicit Random(const uint32_t seed) : rng(seed) {}
+        int Int(const int lo, const int hi) { return std::uniform_int_distribution(lo, hi)(rng); }
+        float Real(const float lo, const float hi) { return std::uniform_real_distribution(lo, hi)(rng); }
+        bool Chance(const float p) { return Real(0.f, 1.f) < p; }
+    };
+
+    FormID StageFormID(const size_t src, const size_t no) { return static_cast<FormID>(0x1000 * (src + 1) + no); }
+
+    constexpr FormID plain_delayer = 0xA001;
+    constexpr FormID plain_transformer = 0xA002;
+
+    // a wait of a_hours from a_t_before: containers with instances picked up in the day before it
+    World MakeWorld(const uint32_t seed, std::vector<RefID>& locs) {
+        Random r(seed);
+        World world;
+        const float t_before = r.Real(30.f, 200.f);
+        world.curr_time = t_before + r.Real(1.f, 24.f);
+        world.forgetting_time = 1000.f;
+
+        const auto n_sources = static_cast<size_t>(r.Int(1, 5));
+        world.sources.resize(n_sources);
+        for (size_t i = 0; i < n_sources; ++i) {
+            auto& src = world.sources[i];
+            const auto n_stages = static_cast<size_t>(r.Int(2, 6));
+            for (size_t k = 0; k < n_stages; ++k) src.stages.push_back({StageFormID(i, k), r.Real(0.3f, 8.f), false});
+            // decays into the first stage of a later source now and then, chains of products
+            if (i + 1 < n_sources && r.Chance(0.4f)) src.settings.decayed_id = StageFormID(static_cast<size_t>(r.Int(static_cast<int>(i) + 1, static_cast<int>(n_sources) - 1)), 0);
+            else src.settings.decayed_id = static_cast<FormID>(0x9000 + i);
+            if (r.Chance(0.5f)) {
+                src.settings.delayers[plain_delayer] = r.Chance(0.5f) ? 0.5f : 2.f;
+                src.settings.delayers_order.push_back(plain_delayer);
+            }
+            // a stage of another source slows this one down: locations with both have to be caught up
+            if (n_sources > 1 && r.Chance(0.15f)) {
+                const auto other = (i + 1) % n_sources;
+                const auto formid = StageFormID(other, static_cast<size_t>(r.Int(0, 1)));
+                src.settings.delayers[formid] = 0.25f;
+                src.settings.delayers_order.push_back(formid);
+            }
+            if (r.Chance(0.2f)) {
+                src.settings.transformers[plain_transformer] = {static_cast<FormID>(0xB000 + i), r.Real(0.5f, 4.f), {1}};
+                src.settings.transformers_order.push_back(plain_transformer);
+            }
+            src.Finish();
+        }
+
+        const auto n_locs = r.Int(1, 12);
+        for (int l = 0; l < n_locs; ++l) {
+            const auto loc = static_cast<RefID>(0x100 + l);
+            auto& inventory = world.inventories[loc];
+            for (size_t i = 0; i < n_sources; ++i) {
+                if (r.Chance(0.4f)) continue;
+                auto& src = world.sources[i];
+                for (int j = r.Int(1, 15); j > 0; --j) {
+                    const float start = t_before - r.Real(0.f, 24.f);
+                    auto& inst = src.data[loc].emplace_back(start, 0u, r.Int(1, 3));
+                    inst.xtra.form_id = src.stages[0].formid;
+                    ++src.n_instances;
+                    inventory[inst.xtra.form_id] += inst.count;
+                }
+            }
+            if (r.Chance(0.4f)) inventory[plain_delayer] = 1;
+            if (r.Chance(0.15f)) inventory[plain_transformer] = 1;
+            // the modulation as it was set when the items were picked up
+            for (size_t i = 0; i < n_sources; ++i) {
+                auto& src = world.sources[i];
+                if (!src.data.contains(loc)) continue;
+                const auto inputs = world.GetModulationInputs(i, loc);
+                for (auto& inst : src.data[loc]) src.SetDelayOfInstance(inst, inst.start_time, inputs);
+            }
+            locs.push_back(loc);
+        }
+        return world;
+    }
+
+    bool SameKind(const ModelInstance& x, const ModelInstance& y) {
+        return x.no == y.no && x.xtra == y.xtra && x.xtra.is_decayed == y.xtra.is_decayed &&
+               x.xtra.is_transforming == y.xtra.is_transforming && x._delay_formid == y._delay_formid && x._delay_mag == y._delay_mag;
+    }
+
+    Count CountOfKind(const std::vector<ModelInstance>& instances, const ModelInstance& x) {
+        Count n = 0;
+        for (const auto& y : instances) {
+            if (SameKind(x, y)) n += y.count;
+        }
+        return n;
+    }
+
+    // every instance of a has one of the same kind in b that started about when it did. AlmostSameExceptCount: instances
+    // closer than this get merged, which start time survives and whether they are still close enough depends on when
+    bool Covered(const std::vector<ModelInstance>& a, const std::vector<ModelInstance>& b) {
+        return std::ranges::all_of(a, [&a, &b](const ModelInstance& x) {
+            return CountOfKind(a, x) == CountOfKind(b, x) && std::ranges::any_of(b, [&x](const ModelInstance& y) {
+                return SameKind(x, y) && std::abs(x.start_time - y.start_time) < 0.015f;
+            });
+        });
+    }
+
+    std::ptrdiff_t Size(const Source& src) {
+        std::ptrdiff_t n = 0;
+        for (const auto& instances : src.data | std::views::values) n += std::ssize(instances);
+        return n;
+    }
+
+    // same up to rounding: the step times of the old loop are a bit after the update times, TimeJump works with the
+    // update times themselves. And up to merging, stepping cleans up at every step
+    bool SameUpToRounding(const World& a, const World& b) {
+        if (a.inventories != b.inventories) return false;
+        for (size_t i = 0; i < a.sources.size(); ++i) {
+            const auto& da = a.sources[i].data;
+            const auto& db = b.sources[i].data;
+            if (da.size() != db.size() || Size(b.sources[i]) != b.sources[i].n_instances) return false;
+            for (const auto& [loc, instances] : da) {
+                const auto it = db.find(loc);
+                if (it == db.end() || !Covered(instances, it->second) || !Covered(it->second, instances)) return false;
+            }
+        }
+        return true;
+    }
+
+    // a location that was caught up: bit for bit
+    bool SameAt(const World& a, const World& b, const RefID loc) {
+        if (a.inventories.at(loc) != b.inventories.at(loc)) return false;
+        for (size_t i = 0; i < a.sources.size(); ++i) {
+            const auto ia = a.sources[i].data.find(loc);
+            const auto ib = b.sources[i].data.find(loc);
+            if ((ia == a.sources[i].data.end()) != (ib == b.sources[i].data.end())) return false;
+            if (ia == a.sources[i].data.end()) continue;
+            if (ia->second.size() != ib->second.size()) return false;
+            for (size_t k = 0; k < ia->second.size(); ++k) {
+                if (!ia->second[k].Identical(ib->second[k])) return false;
+            }
+        }
+        return true;
+    }
+
+    TimeJump<TimeJumpModel>::Stats total;
+
+    bool Compare(const uint32_t seed) {
+        std::vector<RefID> locs;
+        const auto world = MakeWorld(seed, locs);
+        auto stepped = world;
+        for (const auto loc : locs) OldCatchUp(stepped, loc);
+        auto jumped = world;
+        TimeJumpModel model{jumped, {}};
+        TimeJump jump(model, jumped.curr_time);
+        jump.Run(locs);
+        const auto& stats = jump.GetStats();
+        total.jumped += stats.jumped;
+        total.caught_up += stats.caught_up;
+        total.updated += stats.updated;
+        total.applied += stats.applied;
+        total.rounds = std::max(total.rounds, stats.rounds);
+        const bool caught_up_same = std::ranges::all_of(model.caught_up, [&](const RefID loc) { return SameAt(stepped, jumped, loc); });
+        if (caught_up_same && SameUpToRounding(stepped, jumped)) return true;
+        std::printf("seed %u differs\n", seed);
+        return false;
+    }
+}
+
+int main() {
+    for (uint32_t seed = 1; seed <= 400; ++seed) {
+        if (!CHECK(Compare(seed))) break;
+    }
+    std::printf("%zu locations jumped, %zu caught up, %zu updates, %zu applied, up to %zu rounds\n", total.jumped,
+                total.caught_up, total.updated, total.applied, total.rounds);
+    CHECK(total.jumped > 2 * total.caught_up);
+    CHECK(total.caught_up > 0);
+    // netting: far fewer inventory changes than updates
+    CHECK(total.applied * 2 < total.updated);
+    CHECK(total.rounds > 1);
+    return Check::Result();
+}
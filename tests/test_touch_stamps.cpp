@@ -0,0 +1,120 @@
+#include "Check.h"
+#include "TouchStamps.h"
+
+// TouchStamps against a map that remembers every touch forever, on random overlapping updates: the same answers,
+// and the stamps go away once nothing pending can need them
+namespace {
+    void Basics() {
+        TouchStamps stamps;
+        stamps.Touch(1);  // nothing pending, nobody can be behind
+        CHECK(stamps.size() == 0);
+
+        const auto a = stamps.Begin();
+        CHECK(!stamps.TouchedSince(1, a));
+        stamps.Touch(1);
+        const auto b = stamps.Begin();
+        stamps.Touch(2);
+        CHECK(stamps.TouchedSince(1, a));
+        CHECK(stamps.TouchedSince(2, a));
+        CHECK(!stamps.TouchedSince(1, b));
+        CHECK(stamps.TouchedSince(2, b));
+
+        stamps.End(a);
+        CHECK(stamps.TouchedSince(2, b));
+        stamps.End(b);
+        CHECK(stamps.size() == 0);
+    }
+
+    bool Compare(const uint32_t seed) {
+        std::mt19937 rng(seed);
+        const auto n_locs = std::uniform_int_distribution<RefID>(1, 300)(rng);
+        TouchStamps stamps;
+        std::unordered_map<RefID, uint64_t> last_touch;  // never pruned
+        uint64_t now = 0;
+        std::vector<std::pair<uint64_t, uint64_t>> pending;  // (token, reference time it was taken at)
+        size_t max_size = 0;
+        for (int op = 0; op < 5000; ++op) {
+            const auto dice = std::uniform_int_distribution(0, 9)(rng);
+            if (dice < 2 || (pending.empty() && dice < 5)) {
+                pending.emplace_back(stamps.Begin(), now);
+            }
+            else if (dice < 4) {
+                const auto k = std::uniform_int_distribution<size_t>(0, pending.size() - 1)(rng);
+                const auto loc = std::uniform_int_distribution<RefID>(1, n_locs)(rng);
+                const auto it = last_touch.find(loc);
+                const bool expected = it != last_touch.end() && it->second > pending[k].second;
+                if (stamps.TouchedSince(loc, pending[k].first) != expected) return false;
+                if (std::uniform_int_distribution(0, 1)(rng)) {
+                    stamps.End(pending[k].first);
+                    pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(k));
+                }
+            }
+            else {
+                const auto loc = std::uniform_int_distribution<RefID>(1, n_locs)(rng);
+                stamps.Touch(loc);
+                last_touch[loc] = ++now;
+            }
+            max_size = std::max(max_size, stamps.size());
+        }
+        for (const auto& [token, at] : pending) stamps.End(token);
+        return stamps.size() == 0 && max_size <= n_locs;
+    }
+
+    // a long session where updates never overlap: the reference map keeps every location ever touched
+    void Bounded() {
+        TouchStamps stamps;
+        size_t max_size = 0;
+        for (RefID loc = 1; loc <= 100000; ++loc) {
+            const auto token = stamps.Begin();
+            stamps.Touch(loc);
+            stamps.Touch(loc + 1);
+            max_size = std::max(max_size, stamps.size());
+            CHECK(stamps.TouchedSince(loc, token));
+            stamps.End(token);
+        }
+        CHECK(max_size == 2);
+        CHECK(stamps.size() == 0);
+    }
+
+    // one update stuck pending while others come and go: pruned down to what the stuck one can need
+    void StuckUpdate() {
+        TouchStamps stamps;
+        const auto stuck = stamps.Begin();
+        stamps.Touch(7);
+        for (RefID loc = 100; loc < 10100; ++loc) {
+            const auto token = stamps.Begin();
+            stamps.Touch(loc);
+            stamps.End(token);
+        }
+        CHECK(stamps.TouchedSince(7, stuck));
+        CHECK(stamps.TouchedSince(5000, stuck));
+        // everything was touched after the stuck token, so it all stays
+        CHECK(stamps.size() == 10001);
+        stamps.End(stuck);
+        CHECK(stamps.size() == 0);
+
+        const auto first = stamps.Begin();
+        stamps.Touch(1);
+        const auto second = stamps.Begin();
+        for (RefID loc = 2; loc < 200; ++loc) stamps.Touch(loc);
+        stamps.End(first);
+        // the pruning after first ended dropped nothing second can need
+        for (RefID loc = 2; loc < 200; ++loc) CHECK(stamps.TouchedSince(loc, second));
+        CHECK(!stamps.TouchedSince(1, second));
+        const auto third = stamps.Begin();
+        stamps.End(third);
+        CHECK(stamps.size() == 198);
+        stamps.End(second);
+        CHECK(stamps.size() == 0);
+    }
+}
+
+int main() {
+    Basics();
+    for (uint32_t seed = 1; seed <= 300; ++seed) {
+        if (!CHECK(Compare(seed))) break;
+    }
+    Bounded();
+    StuckUpdate();
+    return Check::Result();
+}